@@ -0,0 +1,374 @@
+#include "vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+ * Микробенчмарки Vector в сравнении с std::vector.
+ * Каждая операция прогревается, затем повторяется заданное число раз.
+ * Внутри повтора операции замеряются пачками по BATCH подряд: перцентили
+ * p50/p90/p99 считаются по времени операции во всех пачках всех повторов,
+ * а пропускная способность - по суммарному времени. Операции над всем
+ * вектором (копирование, обход, резервирование) замеряются одним вызовом.
+ *
+ * Запуск: benchmark [--size N] [--reps R] [--warmup W] [--format table|csv|json]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Не даёт компилятору выбросить вычисления, результат которых не используется
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Типы элементов
+ */
+
+// Элемент с перемещением без исключений: Vector перемещает его при реаллокации
+struct NothrowMove {
+    explicit NothrowMove(size_t i)
+        : payload(std::to_string(i) + "-padding-beyond-sso") {
+    }
+    NothrowMove(const NothrowMove&) = default;
+    NothrowMove(NothrowMove&&) noexcept = default;
+    NothrowMove& operator=(const NothrowMove&) = default;
+    NothrowMove& operator=(NothrowMove&&) noexcept = default;
+
+    std::string payload;
+};
+
+// Элемент, чьё перемещение может бросить: при реаллокации его приходится копировать
+struct ThrowingMove {
+    explicit ThrowingMove(size_t i)
+        : payload(std::to_string(i) + "-padding-beyond-sso") {
+    }
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove(ThrowingMove&& other) noexcept(false)
+        : payload(std::move(other.payload)) {
+    }
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&& other) noexcept(false) {
+        payload = std::move(other.payload);
+        return *this;
+    }
+
+    std::string payload;
+};
+
+template <typename T>
+T MakeValue(size_t i) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<T>(i);
+    } else {
+        return T(i);
+    }
+}
+
+template <typename T>
+size_t Touch(const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<size_t>(value);
+    } else {
+        return value.payload.size();
+    }
+}
+
+/**
+ * Единый интерфейс к сравниваемым контейнерам
+ */
+
+template <typename T>
+struct StdVectorOps {
+    using Container = std::vector<T>;
+    static constexpr std::string_view NAME = "std::vector";
+
+    static void EmplaceBack(Container& c, size_t i) {
+        c.emplace_back(MakeValue<T>(i));
+    }
+    static void Insert(Container& c, size_t pos, size_t i) {
+        c.insert(c.begin() + pos, MakeValue<T>(i));
+    }
+    static void Erase(Container& c, size_t pos) {
+        c.erase(c.begin() + pos);
+    }
+    static void Reserve(Container& c, size_t n) {
+        c.reserve(n);
+    }
+    static size_t Size(const Container& c) {
+        return c.size();
+    }
+};
+
+template <typename T>
+struct VectorOps {
+    using Container = Vector<T>;
+    static constexpr std::string_view NAME = "Vector";
+
+    static void EmplaceBack(Container& c, size_t i) {
+        c.EmplaceBack(MakeValue<T>(i));
+    }
+    static void Insert(Container& c, size_t pos, size_t i) {
+        c.Insert(c.begin() + pos, MakeValue<T>(i));
+    }
+    static void Erase(Container& c, size_t pos) {
+        c.Erase(c.begin() + pos);
+    }
+    static void Reserve(Container& c, size_t n) {
+        c.Reserve(n);
+    }
+    static size_t Size(const Container& c) {
+        return c.Size();
+    }
+};
+
+/**
+ * Измерение
+ */
+
+struct Options {
+    size_t size = 100'000;
+    size_t reps = 15;
+    size_t warmup = 3;
+    std::string format = "table";
+};
+
+// Вызов часов стоит десятки наносекунд; пачка растворяет его в операциях,
+// но остаётся достаточно короткой, чтобы в перцентилях были видны редкие
+// дорогие операции вроде реаллокации
+constexpr size_t BATCH = 32;
+
+struct Result {
+    std::string_view container;
+    std::string_view element;
+    std::string_view operation;
+    size_t ops_per_rep = 0;
+    size_t reps = 0;
+    // Время операции в каждой замеренной пачке, нс; отсортировано по возрастанию
+    std::vector<double> ns_per_op;
+    double total_ns = 0;
+    double total_ops = 0;
+
+    double Percentile(double p) const {
+        const size_t index = static_cast<size_t>(p * static_cast<double>(ns_per_op.size() - 1) + 0.5);
+        return ns_per_op[index];
+    }
+
+    double Mean() const {
+        return total_ns / total_ops;
+    }
+};
+
+// setup готовит состояние вне замера; step(state, i) выполняет шаг i из steps,
+// каждый шаг - ops_per_step операций. Шаги замеряются пачками по BATCH
+template <typename State, typename Setup, typename Step>
+Result Measure(const Options& options, size_t steps, size_t ops_per_step, Setup setup, Step step) {
+    Result result;
+    result.ops_per_rep = steps * ops_per_step;
+    result.reps = options.reps;
+    for (size_t rep = 0; rep < options.warmup + options.reps; ++rep) {
+        State state = setup();
+        for (size_t first = 0; first < steps; first += BATCH) {
+            const size_t last = std::min(first + BATCH, steps);
+            const auto start = Clock::now();
+            for (size_t i = first; i < last; ++i) {
+                step(state, i);
+            }
+            const auto finish = Clock::now();
+            if (rep >= options.warmup) {
+                const double ns = std::chrono::duration<double, std::nano>(finish - start).count();
+                const double ops = static_cast<double>((last - first) * ops_per_step);
+                result.ns_per_op.push_back(ns / ops);
+                result.total_ns += ns;
+                result.total_ops += ops;
+            }
+        }
+        DoNotOptimize(state);
+    }
+    std::sort(result.ns_per_op.begin(), result.ns_per_op.end());
+    return result;
+}
+
+template <typename Ops>
+typename Ops::Container Filled(size_t n) {
+    typename Ops::Container c;
+    for (size_t i = 0; i < n; ++i) {
+        Ops::EmplaceBack(c, i);
+    }
+    return c;
+}
+
+template <typename Ops>
+void RunSuite(const Options& options, std::string_view element, std::vector<Result>& results) {
+    using Container = typename Ops::Container;
+    const size_t n = options.size;
+    // Вставки и удаления в начале и середине квадратичны, поэтому их меньше
+    const size_t edits = std::max<size_t>(1, n / 100);
+
+    auto add = [&](std::string_view operation, Result result) {
+        result.container = Ops::NAME;
+        result.element = element;
+        result.operation = operation;
+        results.push_back(std::move(result));
+    };
+    auto empty = [] {
+        return Container{};
+    };
+    auto filled = [n] {
+        return Filled<Ops>(n);
+    };
+
+    add("emplace_back", Measure<Container>(options, n, 1, empty, [](Container& c, size_t i) {
+        Ops::EmplaceBack(c, i);
+    }));
+    // Резервирование входит в первую пачку
+    add("emplace_back_reserved", Measure<Container>(options, n, 1, empty, [n](Container& c, size_t i) {
+        if (i == 0) {
+            Ops::Reserve(c, n);
+        }
+        Ops::EmplaceBack(c, i);
+    }));
+    add("insert_front", Measure<Container>(options, edits, 1, filled, [](Container& c, size_t i) {
+        Ops::Insert(c, 0, i);
+    }));
+    add("insert_middle", Measure<Container>(options, edits, 1, filled, [](Container& c, size_t i) {
+        Ops::Insert(c, Ops::Size(c) / 2, i);
+    }));
+    add("erase_middle", Measure<Container>(options, edits, 1, filled, [](Container& c, size_t) {
+        Ops::Erase(c, Ops::Size(c) / 2);
+    }));
+    add("reserve_grow", Measure<Container>(options, 1, n, filled, [n](Container& c, size_t) {
+        Ops::Reserve(c, n * 2);
+    }));
+    // Копия и перемещённый вектор живут в состоянии, чтобы их разрушение не попадало в замер
+    using Pair = std::pair<Container, Container>;
+    auto filled_pair = [n] {
+        return Pair(Filled<Ops>(n), Container{});
+    };
+    add("copy", Measure<Pair>(options, 1, n, filled_pair, [](Pair& p, size_t) {
+        p.second = p.first;
+    }));
+    add("move", Measure<Pair>(options, 1, 1, filled_pair, [](Pair& p, size_t) {
+        p.second = std::move(p.first);
+    }));
+    add("iterate", Measure<Container>(options, 1, n, filled, [](Container& c, size_t) {
+        size_t sum = 0;
+        for (const auto& x : c) {
+            sum += Touch(x);
+        }
+        DoNotOptimize(sum);
+    }));
+}
+
+template <typename T>
+void RunBoth(const Options& options, std::string_view element, std::vector<Result>& results) {
+    RunSuite<StdVectorOps<T>>(options, element, results);
+    RunSuite<VectorOps<T>>(options, element, results);
+}
+
+/**
+ * Вывод
+ */
+
+void PrintTable(const std::vector<Result>& results) {
+    using namespace std;
+    cout << left << setw(12) << "container" << setw(14) << "element" << setw(24) << "operation" << right
+         << setw(12) << "p50 ns/op" << setw(12) << "p90 ns/op" << setw(12) << "p99 ns/op" << setw(14)
+         << "Mops/s" << '\n';
+    cout << fixed << setprecision(2);
+    for (const Result& r : results) {
+        cout << left << setw(12) << r.container << setw(14) << r.element << setw(24) << r.operation << right
+             << setw(12) << r.Percentile(0.5) << setw(12) << r.Percentile(0.9) << setw(12) << r.Percentile(0.99)
+             << setw(14) << 1e3 / r.Mean() << '\n';
+    }
+}
+
+void PrintCsv(const std::vector<Result>& results) {
+    std::cout << "container,element,operation,ops_per_rep,reps,samples,min_ns,p50_ns,p90_ns,p99_ns,mean_ns,ops_per_sec\n";
+    for (const Result& r : results) {
+        std::cout << r.container << ',' << r.element << ',' << r.operation << ',' << r.ops_per_rep << ','
+                  << r.reps << ',' << r.ns_per_op.size() << ',' << r.ns_per_op.front() << ',' << r.Percentile(0.5)
+                  << ',' << r.Percentile(0.9) << ',' << r.Percentile(0.99) << ',' << r.Mean() << ','
+                  << 1e9 / r.Mean() << '\n';
+    }
+}
+
+void PrintJson(const std::vector<Result>& results) {
+    std::cout << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::cout << "  {\"container\": \"" << r.container << "\", \"element\": \"" << r.element
+                  << "\", \"operation\": \"" << r.operation << "\", \"ops_per_rep\": " << r.ops_per_rep
+                  << ", \"reps\": " << r.reps << ", \"samples\": " << r.ns_per_op.size() << ", \"min_ns\": " << r.ns_per_op.front()
+                  << ", \"p50_ns\": " << r.Percentile(0.5) << ", \"p90_ns\": " << r.Percentile(0.9)
+                  << ", \"p99_ns\": " << r.Percentile(0.99) << ", \"mean_ns\": " << r.Mean()
+                  << ", \"ops_per_sec\": " << 1e9 / r.Mean() << '}' << (i + 1 < results.size() ? "," : "")
+                  << '\n';
+    }
+    std::cout << "]\n";
+}
+
+Options ParseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i += 2) {
+        const std::string_view key = argv[i];
+        if (i + 1 == argc) {
+            throw std::invalid_argument("Option " + std::string(key) + " requires a value");
+        }
+        const char* value = argv[i + 1];
+        if (key == "--size") {
+            options.size = std::strtoull(value, nullptr, 10);
+        } else if (key == "--reps") {
+            options.reps = std::strtoull(value, nullptr, 10);
+        } else if (key == "--warmup") {
+            options.warmup = std::strtoull(value, nullptr, 10);
+        } else if (key == "--format") {
+            options.format = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + std::string(key));
+        }
+    }
+    if (options.size == 0 || options.reps == 0) {
+        throw std::invalid_argument("--size and --reps must be positive");
+    }
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+        std::vector<Result> results;
+        RunBoth<int>(options, "trivial", results);
+        RunBoth<NothrowMove>(options, "nothrow_move", results);
+        RunBoth<ThrowingMove>(options, "throwing_move", results);
+
+        if (options.format == "csv") {
+            PrintCsv(results);
+        } else if (options.format == "json") {
+            PrintJson(results);
+        } else {
+            PrintTable(results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,278 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+
+/*
+ * Упакованный битовый вектор: один бит на флаг вместо байта у Vector<bool>.
+ * Биты хранятся в 64-битных словах, что позволяет считать, искать и
+ * комбинировать вектора целыми словами.
+ * Инвариант: биты последнего слова, лежащие за пределами Size(), равны нулю.
+ */
+class BitVector {
+public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+    // Возвращается функциями поиска, если подходящего бита нет
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    /**
+     * Прокси-ссылка на отдельный бит
+     */
+    class Reference {
+    public:
+        Reference(Word* word, Word mask) noexcept
+            : word_(word)
+            , mask_(mask) {
+        }
+
+        Reference& operator=(bool value) noexcept {
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        Word* word_;
+        Word mask_;
+    };
+
+    /**
+     * Конструкторы
+     */
+    BitVector() = default;
+
+    explicit BitVector(size_t size, bool value = false)
+        : words_(WordsFor(size))
+        , size_(size) {
+        if (value) {
+            std::fill(words_.begin(), words_.end(), ~Word{0});
+            ClearTail();
+        }
+    }
+
+    /**
+     * Операторы
+     */
+
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / WORD_BITS] & MaskOf(index)) != 0;
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(&words_[index / WORD_BITS], MaskOf(index));
+    }
+
+    BitVector& operator&=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            words_[i] &= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            words_[i] |= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            words_[i] ^= rhs.words_[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Вместимость в битах
+    size_t Capacity() const noexcept {
+        return words_.Capacity() * WORD_BITS;
+    }
+
+    void Reserve(size_t new_capacity) {
+        words_.Reserve(WordsFor(new_capacity));
+    }
+
+    void Swap(BitVector& other) noexcept {
+        words_.Swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    void PushBack(bool value) {
+        if (size_ % WORD_BITS == 0) {
+            words_.PushBack(Word{0});
+        }
+        if (value) {
+            words_[size_ / WORD_BITS] |= MaskOf(size_);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+        --size_;
+        words_[size_ / WORD_BITS] &= ~MaskOf(size_);
+        if (size_ % WORD_BITS == 0) {
+            words_.PopBack();
+        }
+    }
+
+    void Resize(size_t new_size, bool value = false) {
+        const size_t old_size = size_;
+        words_.Resize(WordsFor(new_size));
+        size_ = new_size;
+        if (new_size < old_size) {
+            ClearTail();
+            return;
+        }
+        if (value) {
+            SetRange(old_size, new_size);
+        }
+    }
+
+    // Удаляет бит index, сдвигая хвост на одну позицию словами целиком
+    void Erase(size_t index) noexcept {
+        assert(index < size_);
+        const size_t word = index / WORD_BITS;
+        const Word low_mask = MaskOf(index) - 1;
+        words_[word] = (words_[word] & low_mask) | ((words_[word] >> 1) & ~low_mask);
+        for (size_t i = word; i + 1 < words_.Size(); ++i) {
+            words_[i] |= words_[i + 1] << (WORD_BITS - 1);
+            words_[i + 1] >>= 1;
+        }
+        --size_;
+        if (size_ % WORD_BITS == 0) {
+            words_.PopBack();
+        }
+    }
+
+    // Количество установленных битов
+    size_t Count() const noexcept {
+        size_t count = 0;
+        for (Word word : words_) {
+            count += PopCount(word);
+        }
+        return count;
+    }
+
+    // Индекс первого установленного бита либо NPOS
+    size_t FindFirst() const noexcept {
+        return FindFrom(0);
+    }
+
+    // Индекс первого установленного бита после pos либо NPOS
+    size_t FindNext(size_t pos) const noexcept {
+        return pos + 1 < size_ ? FindFrom(pos + 1) : NPOS;
+    }
+
+    // Прямой доступ к словам для внешних пословных алгоритмов
+    const Word* Words() const noexcept {
+        return words_.begin();
+    }
+
+    size_t WordCount() const noexcept {
+        return words_.Size();
+    }
+
+private:
+    Vector<Word> words_;
+    size_t size_ = 0;
+
+    static size_t WordsFor(size_t bits) noexcept {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    static Word MaskOf(size_t index) noexcept {
+        return Word{1} << (index % WORD_BITS);
+    }
+
+    static size_t PopCount(Word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word != 0; word &= word - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    static size_t CountTrailingZeros(Word word) noexcept {
+        assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t count = 0;
+        for (; (word & 1) == 0; word >>= 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    size_t FindFrom(size_t pos) const noexcept {
+        if (pos >= size_) {
+            return NPOS;
+        }
+        size_t word = pos / WORD_BITS;
+        Word bits = words_[word] & ~(MaskOf(pos) - 1);
+        while (bits == 0) {
+            if (++word == words_.Size()) {
+                return NPOS;
+            }
+            bits = words_[word];
+        }
+        return word * WORD_BITS + CountTrailingZeros(bits);
+    }
+
+    // Устанавливает биты в диапазоне [first, last)
+    void SetRange(size_t first, size_t last) noexcept {
+        for (; first < last && first % WORD_BITS != 0; ++first) {
+            words_[first / WORD_BITS] |= MaskOf(first);
+        }
+        for (; first + WORD_BITS <= last; first += WORD_BITS) {
+            words_[first / WORD_BITS] = ~Word{0};
+        }
+        for (; first < last; ++first) {
+            words_[first / WORD_BITS] |= MaskOf(first);
+        }
+    }
+
+    // Обнуляет биты последнего слова за пределами size_
+    void ClearTail() noexcept {
+        if (size_ % WORD_BITS != 0) {
+            words_[size_ / WORD_BITS] &= MaskOf(size_) - 1;
+        }
+    }
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#if __cplusplus < 202002L
+#error "Adaptive Vector capacity requires C++20 (std::source_location)"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+#include <thread>
+
+/*
+ * Подсказки начальной ёмкости, выученные по месту конструирования вектора.
+ * Для каждого места хранится гистограмма итоговых размеров прежних векторов
+ * по степеням двойки; первое выделение нового вектора сразу берёт ёмкость,
+ * которой хватило PERCENTILE процентам предшественников, вместо цепочки
+ * 1, 2, 4, 8... Гистограммы общие для всех потоков и обновляются без блокировок.
+ *
+ * Модуль подключается из vector.h при определённом ADVANCED_VECTOR_ADAPTIVE_CAPACITY.
+ */
+namespace capacity_hints {
+
+// Подсказка выдаётся после стольких наблюдений за местом
+inline constexpr uint64_t MIN_SAMPLES = 8;
+// Доля предшественников в процентах, которым должно хватить подсказанной ёмкости
+inline constexpr uint64_t PERCENTILE = 90;
+// Подсказка не превышает 2^(BUCKETS - 2) элементов
+inline constexpr size_t BUCKETS = 32;
+
+namespace detail {
+
+// Запись места вызова. Ключ записывается один раз захватившим запись потоком
+struct Site {
+    static constexpr uint32_t FREE = 0;
+    static constexpr uint32_t CLAIMING = 1;
+    static constexpr uint32_t READY = 2;
+
+    std::atomic<uint32_t> state{FREE};
+    const char* file = nullptr;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    // Корзина b > 0 считает размеры из (2^(b - 2), 2^(b - 1)], корзина 0 - пустые вектора
+    std::atomic<uint64_t> histogram[BUCKETS] = {};
+};
+
+inline constexpr size_t TABLE_SIZE = 4096;
+
+inline Site* Table() noexcept {
+    static Site table[TABLE_SIZE];
+    return table;
+}
+
+inline size_t BucketOf(size_t size) noexcept {
+    size_t bucket = 0;
+    for (size_t bound = 1; size > 0 && bucket < BUCKETS - 1; bound <<= 1) {
+        ++bucket;
+        if (size <= bound) {
+            break;
+        }
+    }
+    return bucket;
+}
+
+// Ищет запись места site, при create захватывая свободную. nullptr, если таблица полна
+inline Site* Find(const std::source_location& site, bool create) noexcept {
+    const size_t hash = reinterpret_cast<uintptr_t>(site.file_name()) * 31 + site.line() * 131 + site.column();
+    for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+        Site& entry = Table()[(hash + probe) % TABLE_SIZE];
+        uint32_t state = entry.state.load(std::memory_order_acquire);
+        if (state == Site::FREE) {
+            if (!create) {
+                return nullptr;
+            }
+            if (entry.state.compare_exchange_strong(state, Site::CLAIMING, std::memory_order_acquire)) {
+                entry.file = site.file_name();
+                entry.line = site.line();
+                entry.column = site.column();
+                entry.state.store(Site::READY, std::memory_order_release);
+                return &entry;
+            }
+        }
+        // Ключ записывается несколькими инструкциями, поэтому захват не бывает долгим
+        while (state != Site::READY) {
+            std::this_thread::yield();
+            state = entry.state.load(std::memory_order_acquire);
+        }
+        if (entry.file == site.file_name() && entry.line == site.line() && entry.column == site.column()) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace detail
+
+// Учитывает итоговый размер вектора, сконструированного в месте site
+inline void Record(const std::source_location& site, size_t final_size) noexcept {
+    if (detail::Site* entry = detail::Find(site, true)) {
+        entry->histogram[detail::BucketOf(final_size)].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Начальная ёмкость для вектора из места site; 1, пока наблюдений недостаточно
+inline size_t Hint(const std::source_location& site) noexcept {
+    const detail::Site* entry = detail::Find(site, false);
+    if (entry == nullptr) {
+        return 1;
+    }
+    uint64_t counts[BUCKETS];
+    uint64_t total = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        counts[b] = entry->histogram[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total < MIN_SAMPLES) {
+        return 1;
+    }
+    uint64_t covered = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        covered += counts[b];
+        if (covered * 100 >= total * PERCENTILE) {
+            return b <= 1 ? 1 : size_t{1} << (b - 1);
+        }
+    }
+    return 1;
+}
+
+}  // namespace capacity_hints
@@ -0,0 +1,248 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+/*
+ * Сжатый вектор неубывающих 64-битных чисел (например, отсортированных
+ * идентификаторов). Значения группируются в блоки по BLOCK_SIZE: для блока
+ * хранится первое значение и минимальная разность соседей (frame of reference),
+ * а остатки разностей упаковываются по одинаковому числу бит.
+ * Индекс блоков (skip index) даёт произвольный доступ и поиск, не распаковывая
+ * весь вектор. Последний неполный блок хранится несжатым.
+ */
+class CompressedIntVector {
+public:
+    static constexpr size_t BLOCK_SIZE = 128;
+
+    /**
+     * Конструкторы
+     */
+    CompressedIntVector() {
+        // Слово-заглушка в конце позволяет распаковщику читать word + 1 без проверок
+        packed_.PushBack(uint64_t{0});
+    }
+
+    /**
+     * Операторы
+     */
+
+    uint64_t operator[](size_t index) const noexcept {
+        assert(index < size_);
+        const size_t block = index / BLOCK_SIZE;
+        const size_t offset = index % BLOCK_SIZE;
+        if (block == blocks_.Size()) {
+            return tail_[offset];
+        }
+        const BlockInfo& info = blocks_[block];
+        const uint64_t* in = packed_.begin() + info.word_offset;
+        uint64_t value = info.first + offset * info.min_delta;
+        // Блок нулевой ширины не занимает слов: in указывает на заглушку, за которой
+        // может кончаться packed_
+        for (size_t i = 0; i < offset && info.bit_width != 0; ++i) {
+            value += Extract(in, i, info.bit_width);
+        }
+        return value;
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t BlockCount() const noexcept {
+        return blocks_.Size() + (tail_.Size() != 0 ? 1 : 0);
+    }
+
+    // Значения должны поступать в неубывающем порядке
+    void PushBack(uint64_t value) {
+        if (size_ != 0 && value < last_) {
+            throw std::invalid_argument("CompressedIntVector values must be non-decreasing");
+        }
+        tail_.PushBack(value);
+        last_ = value;
+        ++size_;
+        if (tail_.Size() == BLOCK_SIZE) {
+            FlushTail();
+        }
+    }
+
+    // Распаковывает блок в out (не меньше BLOCK_SIZE элементов) и возвращает число значений в нём
+    size_t DecodeBlock(size_t block, uint64_t* out) const noexcept {
+        assert(block < BlockCount());
+        if (block == blocks_.Size()) {
+            std::copy(tail_.begin(), tail_.end(), out);
+            return tail_.Size();
+        }
+        const BlockInfo& info = blocks_[block];
+        Unpackers()[info.bit_width](packed_.begin() + info.word_offset, out + 1);
+        uint64_t value = info.first;
+        out[0] = value;
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            value += out[i] + info.min_delta;
+            out[i] = value;
+        }
+        return BLOCK_SIZE;
+    }
+
+    // Последовательно вызывает f для каждого значения, распаковывая по блоку за раз
+    template <typename F>
+    void ForEach(F&& f) const {
+        uint64_t buffer[BLOCK_SIZE];
+        for (size_t block = 0; block < BlockCount(); ++block) {
+            const size_t count = DecodeBlock(block, buffer);
+            for (size_t i = 0; i < count; ++i) {
+                f(buffer[i]);
+            }
+        }
+    }
+
+    Vector<uint64_t> Decode() const {
+        Vector<uint64_t> result;
+        result.Reserve(BlockCount() * BLOCK_SIZE);
+        for (size_t block = 0; block < BlockCount(); ++block) {
+            DecodeBlock(block, result.AppendUninitialized(BLOCK_SIZE));
+        }
+        result.Resize(size_);
+        return result;
+    }
+
+    // Индекс первого значения, не меньшего value, либо Size()
+    size_t LowerBound(uint64_t value) const noexcept {
+        // Ищем последний блок, первое значение которого меньше value
+        size_t lo = 0;
+        size_t hi = blocks_.Size();
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (blocks_[mid].first < value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        size_t block = lo == 0 ? 0 : lo - 1;
+        if (lo == blocks_.Size() && tail_.Size() != 0 && tail_[0] < value) {
+            block = blocks_.Size();
+        }
+        if (block >= BlockCount()) {
+            return size_;
+        }
+        uint64_t buffer[BLOCK_SIZE];
+        const size_t count = DecodeBlock(block, buffer);
+        const uint64_t* pos = std::lower_bound(buffer, buffer + count, value);
+        return block * BLOCK_SIZE + (pos - buffer);
+    }
+
+    // Объём занимаемой памяти в байтах
+    size_t MemoryUsage() const noexcept {
+        return blocks_.Capacity() * sizeof(BlockInfo) + packed_.Capacity() * sizeof(uint64_t)
+            + tail_.Capacity() * sizeof(uint64_t);
+    }
+
+private:
+    // Элемент индекса блоков
+    struct BlockInfo {
+        uint64_t first = 0;
+        uint64_t min_delta = 0;
+        size_t word_offset = 0;
+        unsigned bit_width = 0;
+    };
+
+    // Распаковывает BLOCK_SIZE - 1 остатков разностей шириной W бит
+    using Unpacker = void (*)(const uint64_t* in, uint64_t* out);
+
+    Vector<BlockInfo> blocks_;
+    Vector<uint64_t> packed_;
+    Vector<uint64_t> tail_;
+    size_t size_ = 0;
+    uint64_t last_ = 0;
+
+    static uint64_t MaskOf(unsigned width) noexcept {
+        return width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+    }
+
+    // Извлекает i-е упакованное число. Сдвиг (x << 1) << (63 - shift) равен x << (64 - shift)
+    // и не даёт неопределённого поведения при shift == 0
+    static uint64_t Extract(const uint64_t* in, size_t i, unsigned width) noexcept {
+        const size_t bit = i * width;
+        const unsigned shift = bit % 64;
+        const uint64_t low = in[bit / 64] >> shift;
+        const uint64_t high = (in[bit / 64 + 1] << 1) << (63 - shift);
+        return (low | high) & MaskOf(width);
+    }
+
+    // Ширина известна при компиляции, поэтому сдвиги и маска становятся константами,
+    // а цикл без ветвлений поддаётся развёртке и векторизации
+    template <unsigned W>
+    static void UnpackFixed(const uint64_t* in, uint64_t* out) noexcept {
+        for (size_t i = 0; i < BLOCK_SIZE - 1; ++i) {
+            out[i] = W == 0 ? 0 : Extract(in, i, W);
+        }
+    }
+
+    template <size_t... Widths>
+    static constexpr auto MakeUnpackers(std::index_sequence<Widths...>) noexcept {
+        return std::array<Unpacker, sizeof...(Widths)>{&UnpackFixed<static_cast<unsigned>(Widths)>...};
+    }
+
+    // Таблица распаковщиков для всех ширин от 0 до 64 бит
+    static const Unpacker* Unpackers() noexcept {
+        static constexpr std::array<Unpacker, 65> unpackers = MakeUnpackers(std::make_index_sequence<65>{});
+        return unpackers.data();
+    }
+
+    static unsigned BitWidth(uint64_t value) noexcept {
+        unsigned width = 0;
+        for (; value != 0; value >>= 1) {
+            ++width;
+        }
+        return width;
+    }
+
+    // Сжимает заполненный несжатый хвост в новый блок
+    void FlushTail() {
+        BlockInfo info;
+        info.first = tail_[0];
+        info.min_delta = tail_[1] - tail_[0];
+        uint64_t max_delta = info.min_delta;
+        for (size_t i = 2; i < BLOCK_SIZE; ++i) {
+            const uint64_t delta = tail_[i] - tail_[i - 1];
+            info.min_delta = std::min(info.min_delta, delta);
+            max_delta = std::max(max_delta, delta);
+        }
+        info.bit_width = BitWidth(max_delta - info.min_delta);
+
+        // Память под блок и его слова выделяется до изменения packed_, чтобы
+        // после этого ничего не могло бросить и оставить packed_ без описания блока
+        if (blocks_.Size() == blocks_.Capacity()) {
+            blocks_.Reserve(std::max<size_t>(blocks_.Size() * 2, 1));
+        }
+
+        // Заглушка в конце packed_ становится первым словом нового блока
+        info.word_offset = packed_.Size() - 1;
+        const size_t words = ((BLOCK_SIZE - 1) * info.bit_width + 63) / 64;
+        packed_.Reserve(std::max(packed_.Size() + words, packed_.Size() * 2));
+        packed_.Resize(packed_.Size() + words);
+
+        uint64_t* out = packed_.begin() + info.word_offset;
+        for (size_t i = 1; i < BLOCK_SIZE && info.bit_width != 0; ++i) {
+            const uint64_t residual = tail_[i] - tail_[i - 1] - info.min_delta;
+            const size_t bit = (i - 1) * info.bit_width;
+            out[bit / 64] |= residual << (bit % 64);
+            if (bit % 64 + info.bit_width > 64) {
+                out[bit / 64 + 1] |= residual >> (64 - bit % 64);
+            }
+        }
+
+        blocks_.PushBack(info);
+        tail_.Resize(0);
+    }
+};
@@ -0,0 +1,321 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Ограниченные очереди без блокировок для передачи элементов между потоками.
+ * Ёмкость фиксируется при создании и округляется вверх до степени двойки,
+ * буфер выделяется один раз в RawMemory. Индексы производителей и потребителей
+ * лежат на разных кеш-линиях, чтобы потоки не делили их при записи.
+ *
+ * Элементы должны перемещаться и присваиваться перемещением без исключений:
+ * занятая, но не заполненная ячейка навсегда остановила бы очередь.
+ */
+
+// Размер кеш-линии, по которому разносятся данные разных потоков
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+namespace queue_detail {
+
+inline size_t RoundUpToPowerOfTwo(size_t n) noexcept {
+    size_t capacity = 1;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+}  // namespace queue_detail
+
+/**
+ * Один производитель, один потребитель
+ */
+
+/*
+ * Каждый индекс пишет только его владелец. Производитель держит копию индекса
+ * потребителя и перечитывает общий атомарный индекс, лишь когда копия
+ * показывает полную очередь (и наоборот), так что в установившемся режиме
+ * потоки не читают кеш-линии друг друга на каждой операции.
+ */
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                  "SpscQueue requires nothrow move operations");
+
+public:
+    /**
+     * Конструкторы
+     */
+    explicit SpscQueue(size_t capacity)
+        : data_(queue_detail::RoundUpToPowerOfTwo(capacity))
+        , mask_(data_.Capacity() - 1) {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        for (size_t i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+            std::destroy_at(data_ + (i & mask_));
+        }
+    }
+
+    /**
+     * Методы производителя
+     */
+
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...>, "Element construction must not throw");
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == Capacity()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity()) {
+                return false;
+            }
+        }
+        vector_detail::ConstructAt(data_ + (tail & mask_), std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(T value) noexcept {
+        return TryEmplace(std::move(value));
+    }
+
+    // Добавляет до n элементов из first одной публикацией и возвращает их число
+    template <typename InputIt>
+    size_t TryPushN(InputIt first, size_t n) {
+        static_assert(std::is_nothrow_constructible_v<T, decltype(*first)>, "Element construction must not throw");
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (Capacity() - (tail - cached_head_) < n) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(n, Capacity() - (tail - cached_head_));
+        for (size_t i = 0; i < count; ++i, ++first) {
+            vector_detail::ConstructAt(data_ + ((tail + i) & mask_), *first);
+        }
+        if (count != 0) {
+            tail_.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * Методы потребителя
+     */
+
+    bool TryPop(T& out) noexcept {
+        return TryPopN(&out, 1) == 1;
+    }
+
+    // Извлекает до n элементов в out одной публикацией и возвращает их число
+    template <typename OutputIt>
+    size_t TryPopN(OutputIt out, size_t n) noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < n) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(n, cached_tail_ - head);
+        for (size_t i = 0; i < count; ++i, ++out) {
+            T* slot = data_ + ((head + i) & mask_);
+            *out = std::move(*slot);
+            std::destroy_at(slot);
+        }
+        if (count != 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * Общие методы
+     */
+
+    size_t Capacity() const noexcept {
+        return mask_ + 1;
+    }
+
+    // Размер на момент вызова; при одновременной работе других потоков приблизителен
+    size_t SizeApprox() const noexcept {
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+private:
+    RawMemory<T> data_;
+    const size_t mask_;
+
+    // Данные потребителя
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // Данные производителя
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
+
+/**
+ * Много производителей, много потребителей
+ */
+
+/*
+ * Очередь Вьюкова: у каждой ячейки есть номер последовательности. Ячейка с
+ * номером pos свободна для записи с позиции pos, с номером pos + 1 - готова
+ * к чтению с позиции pos. Поток захватывает позиции одним CAS общего индекса,
+ * а готовность публикует записью номера своей ячейки, поэтому производители
+ * и потребители не ждут друг друга. Ячейки выровнены по кеш-линии, чтобы
+ * соседние позиции, обрабатываемые разными потоками, не делили линию.
+ */
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                  "MpmcQueue requires nothrow move operations");
+
+public:
+    /**
+     * Конструкторы
+     */
+    explicit MpmcQueue(size_t capacity)
+        : slots_(queue_detail::RoundUpToPowerOfTwo(capacity))
+        , mask_(slots_.Capacity() - 1) {
+        for (size_t i = 0; i < slots_.Capacity(); ++i) {
+            vector_detail::ConstructAt(slots_ + i, i);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue() {
+        const size_t enqueue = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != enqueue; ++pos) {
+            std::destroy_at(slots_[pos & mask_].Value());
+        }
+        std::destroy_n(slots_.GetAddress(), slots_.Capacity());
+    }
+
+    /**
+     * Методы
+     */
+
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...>, "Element construction must not throw");
+        const auto [pos, count] = Claim(enqueue_pos_, 0, 1);
+        if (count == 0) {
+            return false;
+        }
+        Slot& slot = slots_[pos & mask_];
+        vector_detail::ConstructAt(slot.Value(), std::forward<Args>(args)...);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(T value) noexcept {
+        return TryEmplace(std::move(value));
+    }
+
+    // Захватывает до n подряд идущих свободных ячеек одним CAS и заполняет их из first
+    template <typename InputIt>
+    size_t TryPushN(InputIt first, size_t n) {
+        static_assert(std::is_nothrow_constructible_v<T, decltype(*first)>, "Element construction must not throw");
+        const auto [pos, count] = Claim(enqueue_pos_, 0, n);
+        for (size_t i = 0; i < count; ++i, ++first) {
+            Slot& slot = slots_[(pos + i) & mask_];
+            vector_detail::ConstructAt(slot.Value(), *first);
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool TryPop(T& out) noexcept {
+        return TryPopN(&out, 1) == 1;
+    }
+
+    // Захватывает до n подряд идущих готовых ячеек одним CAS и извлекает их в out
+    template <typename OutputIt>
+    size_t TryPopN(OutputIt out, size_t n) noexcept {
+        const auto [pos, count] = Claim(dequeue_pos_, 1, n);
+        for (size_t i = 0; i < count; ++i, ++out) {
+            Slot& slot = slots_[(pos + i) & mask_];
+            *out = std::move(*slot.Value());
+            std::destroy_at(slot.Value());
+            // Ячейка освобождается для записи на следующем круге
+            slot.sequence.store(pos + i + Capacity(), std::memory_order_release);
+        }
+        return count;
+    }
+
+    size_t Capacity() const noexcept {
+        return mask_ + 1;
+    }
+
+    // Размер на момент вызова; при одновременной работе других потоков приблизителен
+    size_t SizeApprox() const noexcept {
+        const size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        explicit Slot(size_t seq) noexcept
+            : sequence(seq) {
+        }
+
+        T* Value() noexcept {
+            return std::launder(reinterpret_cast<T*>(&storage));
+        }
+
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Позиции, захваченные вызовом Claim
+    struct Claimed {
+        size_t pos = 0;
+        size_t count = 0;
+    };
+
+    RawMemory<Slot> slots_;
+    const size_t mask_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+
+    // Захватывает до n ячеек с позиции индекса position, номер которых равен позиции
+    // плюс lag (0 для записи, 1 для чтения). Возвращает 0 ячеек, если первая не готова
+    Claimed Claim(std::atomic<size_t>& position, size_t lag, size_t n) noexcept {
+        size_t pos = position.load(std::memory_order_relaxed);
+        while (n != 0) {
+            size_t count = 0;
+            while (count < n && slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire)
+                                    == pos + count + lag) {
+                ++count;
+            }
+            if (count == 0) {
+                const size_t seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+                // Номер отстаёт от позиции: очередь полна (или пуста для чтения)
+                if (static_cast<std::ptrdiff_t>(seq - (pos + lag)) < 0) {
+                    return {};
+                }
+                // Другой поток уже продвинул индекс
+                pos = position.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                return {pos, count};
+            }
+        }
+        return {};
+    }
+};
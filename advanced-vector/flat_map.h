@@ -0,0 +1,170 @@
+#pragma once
+#include "flat_set.h"
+#include "vector.h"
+
+#include <functional>
+#include <utility>
+
+/*
+ * Ассоциативный массив поверх двух Vector: отсортированных ключей и значений
+ * с теми же индексами. Поиск идёт только по плотному массиву ключей,
+ * а значения затрагиваются лишь для найденного элемента.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    /**
+     * Конструкторы
+     */
+    FlatMap() = default;
+
+    explicit FlatMap(Compare cmp)
+        : cmp_(std::move(cmp)) {
+    }
+
+    /**
+     * Операторы
+     */
+
+    // Возвращает значение по ключу, вставляя значение по умолчанию при его отсутствии
+    Value& operator[](const Key& key) {
+        return *TryEmplace(key).first;
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+        values_.Reserve(new_capacity);
+    }
+
+    const Vector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    const Vector<Value>& Values() const noexcept {
+        return values_;
+    }
+
+    const Key& KeyAt(size_t index) const noexcept {
+        return keys_[index];
+    }
+
+    Value& ValueAt(size_t index) noexcept {
+        return values_[index];
+    }
+
+    const Value& ValueAt(size_t index) const noexcept {
+        return values_[index];
+    }
+
+    // Указатель на значение либо nullptr, если ключа нет
+    Value* Find(const Key& key) {
+        const size_t index = IndexOf(key);
+        return index != keys_.Size() ? &values_[index] : nullptr;
+    }
+
+    const Value* Find(const Key& key) const {
+        return const_cast<FlatMap&>(*this).Find(key);
+    }
+
+    bool Contains(const Key& key) const {
+        return IndexOf(key) != keys_.Size();
+    }
+
+    // Конструирует значение из args, если ключа ещё нет. Если конструирование
+    // значения бросает исключение, вставленный ключ удаляется
+    template <typename... Args>
+    std::pair<Value*, bool> TryEmplace(const Key& key, Args&&... args) {
+        const size_t index = LowerBoundIndex(key);
+        if (index != keys_.Size() && !cmp_(key, keys_[index])) {
+            return {&values_[index], false};
+        }
+        keys_.Emplace(keys_.begin() + index, key);
+        try {
+            values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.Erase(keys_.begin() + index);
+            throw;
+        }
+        return {&values_[index], true};
+    }
+
+    std::pair<Value*, bool> Insert(const Key& key, const Value& value) {
+        return TryEmplace(key, value);
+    }
+
+    std::pair<Value*, bool> Insert(const Key& key, Value&& value) {
+        return TryEmplace(key, std::move(value));
+    }
+
+    bool Erase(const Key& key) {
+        const size_t index = IndexOf(key);
+        if (index == keys_.Size()) {
+            return false;
+        }
+        keys_.Erase(keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+        return true;
+    }
+
+    // Сортирует пары и сливает их с содержимым за один проход. Существующие ключи
+    // не заменяются, из повторов внутри items берётся первый.
+    // Если перемещение ключей и значений не бросает исключений, даёт строгую гарантию
+    void InsertBatch(Vector<std::pair<Key, Value>> items) {
+        std::stable_sort(items.begin(), items.end(), [this](const auto& lhs, const auto& rhs) {
+            return cmp_(lhs.first, rhs.first);
+        });
+
+        Vector<Key> keys;
+        Vector<Value> values;
+        keys.Reserve(keys_.Size() + items.Size());
+        values.Reserve(keys_.Size() + items.Size());
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < items.Size()) {
+            if (j == items.Size() || (i < keys_.Size() && !cmp_(items[j].first, keys_[i]))) {
+                keys.PushBack(std::move_if_noexcept(keys_[i]));
+                values.PushBack(std::move_if_noexcept(values_[i]));
+                ++i;
+            } else {
+                keys.PushBack(std::move(items[j].first));
+                values.PushBack(std::move(items[j].second));
+                ++j;
+            }
+            const Key& last = keys[keys.Size() - 1];
+            while (j < items.Size() && !cmp_(last, items[j].first)) {
+                ++j;
+            }
+        }
+
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+private:
+    Vector<Key> keys_;
+    Vector<Value> values_;
+    Compare cmp_;
+
+    size_t LowerBoundIndex(const Key& key) const {
+        return FlatLowerBound(keys_.begin(), keys_.Size(), key, cmp_) - keys_.begin();
+    }
+
+    // Индекс ключа либо Size(), если его нет
+    size_t IndexOf(const Key& key) const {
+        const size_t index = LowerBoundIndex(key);
+        return index != keys_.Size() && !cmp_(key, keys_[index]) ? index : keys_.Size();
+    }
+};
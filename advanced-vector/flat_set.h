@@ -0,0 +1,177 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Бинарный поиск без ветвлений: на каждом шаге выбор половины компилируется
+// в условное перемещение, поэтому промахи предсказателя переходов не копятся
+template <typename Key, typename Compare>
+const Key* FlatLowerBound(const Key* first, size_t n, const Key& key, const Compare& cmp) {
+    if (n == 0) {
+        return first;
+    }
+    const Key* base = first;
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = cmp(base[half - 1], key) ? base + half : base;
+        n -= half;
+    }
+    return base + (cmp(*base, key) ? 1 : 0);
+}
+
+/*
+ * Множество, хранящее отсортированные ключи в непрерывном Vector.
+ * Вставка и удаление одиночных ключей линейны, поиск логарифмичен,
+ * а пакетная вставка сортирует новые ключи и сливает их с существующими один раз.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+public:
+    using const_iterator = const Key*;
+
+    /**
+     * Конструкторы
+     */
+    FlatSet() = default;
+
+    explicit FlatSet(Compare cmp)
+        : cmp_(std::move(cmp)) {
+    }
+
+    /**
+     * Итераторы
+     */
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return keys_.Capacity();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return FlatLowerBound(keys_.begin(), keys_.Size(), key, cmp_);
+    }
+
+    const_iterator Find(const Key& key) const {
+        const_iterator pos = LowerBound(key);
+        return pos != end() && !cmp_(key, *pos) ? pos : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    // Гарантии безопасности исключений совпадают с Vector::Emplace
+    template <typename... Args>
+    std::pair<const_iterator, bool> Emplace(Args&&... args) {
+        Key key(std::forward<Args>(args)...);
+        const_iterator pos = LowerBound(key);
+        if (pos != end() && !cmp_(key, *pos)) {
+            return {pos, false};
+        }
+        return {keys_.Emplace(pos, std::move(key)), true};
+    }
+
+    std::pair<const_iterator, bool> Insert(const Key& key) {
+        return Emplace(key);
+    }
+
+    std::pair<const_iterator, bool> Insert(Key&& key) {
+        return Emplace(std::move(key));
+    }
+
+    bool Erase(const Key& key) {
+        const_iterator pos = Find(key);
+        if (pos == end()) {
+            return false;
+        }
+        keys_.Erase(pos);
+        return true;
+    }
+
+    // Сортирует новые ключи и сливает их с существующими за один проход в новый буфер.
+    // Уже имеющиеся ключи не заменяются, из повторов внутри пачки берётся первый.
+    // Сравнения делаются до того, как тронуто содержимое, поэтому исключение из
+    // сравнения или копирования оставляет множество прежним
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last) {
+        Vector<Key> batch;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            batch.Reserve(std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            batch.EmplaceBack(*first);
+        }
+        std::stable_sort(batch.begin(), batch.end(), cmp_);
+        const Key* batch_end = std::unique(batch.begin(), batch.end(), [this](const Key& lhs, const Key& rhs) {
+            return !cmp_(lhs, rhs);
+        });
+        while (batch.end() != batch_end) {
+            batch.PopBack();
+        }
+
+        // Позиция в keys_, перед которой встаёт каждый новый ключ; NONE - ключ уже есть
+        constexpr size_t NONE = static_cast<size_t>(-1);
+        Vector<size_t> positions;
+        positions.Reserve(batch.Size());
+        size_t added = 0;
+        size_t i = 0;
+        for (const Key& key : batch) {
+            i = FlatLowerBound(keys_.begin() + i, keys_.Size() - i, key, cmp_) - keys_.begin();
+            const bool exists = i < keys_.Size() && !cmp_(key, keys_[i]);
+            positions.PushBack(exists ? NONE : i);
+            added += exists ? 0 : 1;
+        }
+        if (added == 0) {
+            return;
+        }
+
+        Vector<Key> merged;
+        merged.Reserve(keys_.Size() + added);
+        i = 0;
+        for (size_t j = 0; j < batch.Size(); ++j) {
+            if (positions[j] == NONE) {
+                continue;
+            }
+            for (; i < positions[j]; ++i) {
+                merged.PushBack(std::move_if_noexcept(keys_[i]));
+            }
+            merged.PushBack(std::move_if_noexcept(batch[j]));
+        }
+        for (; i < keys_.Size(); ++i) {
+            merged.PushBack(std::move_if_noexcept(keys_[i]));
+        }
+        keys_.Swap(merged);
+    }
+
+private:
+    Vector<Key> keys_;
+    Compare cmp_;
+};
@@ -0,0 +1,255 @@
+#pragma once
+#include "index_iterator.h"
+#include "vector.h"
+#include "vector_view.h"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Буфер с разрывом (gap buffer): свободная часть ёмкости хранится не в конце,
+ * а в месте последней правки. Вставка и удаление рядом с разрывом стоят O(1),
+ * а перенос разрыва на расстояние d - O(d), поэтому серия правок вокруг одной
+ * позиции (как в текстовом редакторе) обходится без сдвига всего хвоста.
+ * Элементы занимают два непрерывных участка: до разрыва и после него.
+ */
+template <typename T>
+class GapVector {
+public:
+    /**
+     * Конструкторы
+     */
+    GapVector() = default;
+
+    GapVector(const GapVector& other)
+        : data_(other.Size())
+        , gap_begin_(other.Size())
+        , gap_end_(other.Size()) {
+        const auto [before, after] = other.Spans();
+        vector_detail::CopyN(before.Data(), before.Size(), data_.GetAddress());
+        try {
+            vector_detail::CopyN(after.Data(), after.Size(), data_ + before.Size());
+        } catch (...) {
+            std::destroy_n(data_.GetAddress(), before.Size());
+            throw;
+        }
+    }
+
+    GapVector(GapVector&& other) noexcept {
+        Swap(other);
+    }
+
+    ~GapVector() {
+        Clear();
+    }
+
+    /**
+     * Итераторы
+     */
+
+    using iterator = IndexIterator<GapVector, T>;
+    using const_iterator = IndexIterator<const GapVector, const T>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, Size());
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, Size());
+    }
+
+    /**
+     * Операторы
+     */
+
+    GapVector& operator=(const GapVector& rhs) {
+        if (this != &rhs) {
+            GapVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    GapVector& operator=(GapVector&& rhs) noexcept {
+        if (this != &rhs) {
+            GapVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<GapVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return data_[index < gap_begin_ ? index : index + GapSize()];
+    }
+
+    /**
+     * Методы
+     */
+
+    void Swap(GapVector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+    }
+
+    size_t Size() const noexcept {
+        return data_.Capacity() - GapSize();
+    }
+
+    bool Empty() const noexcept {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Позиция разрыва: номер первого элемента после него
+    size_t GapPosition() const noexcept {
+        return gap_begin_;
+    }
+
+    // Элементы по порядку: участок до разрыва и участок после него
+    std::pair<VectorView<T>, VectorView<T>> Spans() noexcept {
+        return {VectorView<T>(data_.GetAddress(), gap_begin_),
+                VectorView<T>(data_ + gap_end_, data_.Capacity() - gap_end_)};
+    }
+
+    std::pair<ConstVectorView<T>, ConstVectorView<T>> Spans() const noexcept {
+        const auto [before, after] = const_cast<GapVector&>(*this).Spans();
+        return {before, after};
+    }
+
+    template <typename... Args>
+    T& Emplace(size_t index, Args&&... args) {
+        assert(index <= Size());
+        // Аргументы могут ссылаться на элементы, которые сдвинутся вместе с разрывом
+        T value(std::forward<Args>(args)...);
+        if (gap_begin_ == gap_end_) {
+            Grow();
+        }
+        MoveGap(index);
+        T* result = vector_detail::ConstructAt(data_ + gap_begin_, std::move(value));
+        ++gap_begin_;
+        return *result;
+    }
+
+    T& Insert(size_t index, const T& value) {
+        return Emplace(index, value);
+    }
+
+    T& Insert(size_t index, T&& value) {
+        return Emplace(index, std::move(value));
+    }
+
+    template <typename B>
+    void PushBack(B&& value) {
+        Emplace(Size(), std::forward<B>(value));
+    }
+
+    void Erase(size_t index) {
+        assert(index < Size());
+        MoveGap(index);
+        std::destroy_at(data_ + gap_end_);
+        ++gap_end_;
+    }
+
+    void PopBack() {
+        Erase(Size() - 1);
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(data_.GetAddress(), gap_begin_);
+        std::destroy_n(data_ + gap_end_, data_.Capacity() - gap_end_);
+        gap_begin_ = 0;
+        gap_end_ = data_.Capacity();
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > data_.Capacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Переносит разрыв так, чтобы он начинался перед элементом index
+    void MoveGap(size_t index) {
+        assert(index <= Size());
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (index < gap_begin_) {
+                const size_t count = gap_begin_ - index;
+                std::memmove(data_ + gap_end_ - count, data_ + index, count * sizeof(T));
+                gap_begin_ -= count;
+                gap_end_ -= count;
+            } else if (index > gap_begin_) {
+                const size_t count = index - gap_begin_;
+                std::memmove(data_ + gap_begin_, data_ + gap_end_, count * sizeof(T));
+                gap_begin_ += count;
+                gap_end_ += count;
+            }
+        } else {
+            // Элементы переезжают по одному через границу разрыва, и после каждого шага
+            // состояние согласовано: исключение при переносе не теряет элементов
+            while (index < gap_begin_) {
+                vector_detail::ConstructAt(data_ + gap_end_ - 1, std::move_if_noexcept(data_[gap_begin_ - 1]));
+                std::destroy_at(data_ + gap_begin_ - 1);
+                --gap_begin_;
+                --gap_end_;
+            }
+            while (index > gap_begin_) {
+                vector_detail::ConstructAt(data_ + gap_begin_, std::move_if_noexcept(data_[gap_end_]));
+                std::destroy_at(data_ + gap_end_);
+                ++gap_begin_;
+                ++gap_end_;
+            }
+        }
+    }
+
+private:
+    RawMemory<T> data_;
+    // Разрыв занимает ячейки [gap_begin_, gap_end_)
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+
+    size_t GapSize() const noexcept {
+        return gap_end_ - gap_begin_;
+    }
+
+    void Grow() {
+        Reallocate(data_.Capacity() == 0 ? 1 : data_.Capacity() * 2);
+    }
+
+    // Переносит оба участка в новый буфер, сохраняя положение разрыва
+    void Reallocate(size_t new_capacity) {
+        RawMemory<T> new_data(new_capacity);
+        const size_t before = gap_begin_;
+        const size_t after = data_.Capacity() - gap_end_;
+        const size_t new_gap_end = new_capacity - after;
+        vector_detail::RelocateN(data_.GetAddress(), before, new_data.GetAddress());
+        try {
+            vector_detail::RelocateN(data_ + gap_end_, after, new_data + new_gap_end);
+        } catch (...) {
+            std::destroy_n(new_data.GetAddress(), before);
+            throw;
+        }
+        Clear();
+        data_.Swap(new_data);
+        gap_begin_ = before;
+        gap_end_ = new_gap_end;
+    }
+};
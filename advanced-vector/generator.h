@@ -0,0 +1,368 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#if !defined(__cpp_impl_coroutine)
+#error "generator.h requires C++20 coroutines"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Наполнение Vector из сопрограмм-производителей без промежуточных векторов.
+ * Производитель выдаёт значения или готовые куски (co_yield), а также может
+ * заранее сообщить, сколько элементов ещё будет (co_yield SizeHint{n}):
+ * приёмник резервирует место сразу и не проходит цепочку удвоений.
+ *
+ * Generator<T> - синхронный производитель: приёмник возобновляет его сам.
+ * AsyncGenerator<T> - производитель, который между выдачами ждёт внешних
+ * событий (co_await на готовность ввода-вывода). Приёмник AppendChunksAsync
+ * сам является сопрограммой: он приостанавливается вместе с производителем и
+ * после каждой выдачи копирует кусок прямо в блок AppendUninitialized. Копирование
+ * и ожидание производителя идут по очереди, а не одновременно.
+ */
+
+// Оценка числа элементов, которые производитель ещё выдаст
+struct SizeHint {
+    size_t count = 0;
+};
+
+namespace generator_detail {
+
+// Общее для обоих генераторов состояние обещания
+template <typename T>
+struct PromiseBase {
+    // Указывает на выданное значение, живущее до возобновления производителя
+    const T* value = nullptr;
+    size_t hint = 0;
+    std::exception_ptr exception;
+
+    // Подсказка не приостанавливает производителя
+    std::suspend_never yield_value(SizeHint size_hint) noexcept {
+        hint = size_hint.count;
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    void return_void() noexcept {
+    }
+
+    void Rethrow() const {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+// Владеет кадром сопрограммы
+template <typename Promise>
+class CoroutineHandle {
+public:
+    CoroutineHandle() = default;
+
+    explicit CoroutineHandle(std::coroutine_handle<Promise> handle) noexcept
+        : handle_(handle) {
+    }
+
+    CoroutineHandle(const CoroutineHandle&) = delete;
+    CoroutineHandle& operator=(const CoroutineHandle&) = delete;
+
+    CoroutineHandle(CoroutineHandle&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})) {
+    }
+
+    CoroutineHandle& operator=(CoroutineHandle&& rhs) noexcept {
+        if (this != &rhs) {
+            CoroutineHandle moved(std::move(rhs));
+            std::swap(handle_, moved.handle_);
+        }
+        return *this;
+    }
+
+    ~CoroutineHandle() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    std::coroutine_handle<Promise> Get() const noexcept {
+        return handle_;
+    }
+
+private:
+    std::coroutine_handle<Promise> handle_;
+};
+
+}  // namespace generator_detail
+
+/**
+ * Синхронный генератор
+ */
+
+template <typename T>
+class Generator {
+public:
+    struct promise_type : generator_detail::PromiseBase<T> {
+        using generator_detail::PromiseBase<T>::yield_value;
+
+        Generator get_return_object() noexcept {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always yield_value(const T& value) noexcept {
+            this->value = std::addressof(value);
+            return {};
+        }
+    };
+
+    // Возобновляет производителя до следующего значения; false, если он завершился
+    bool Next() {
+        const auto handle = coroutine_.Get();
+        handle.resume();
+        handle.promise().Rethrow();
+        return !handle.done();
+    }
+
+    // Значение, выданное последним Next(); действительно до следующего вызова Next()
+    const T& Value() const noexcept {
+        return *coroutine_.Get().promise().value;
+    }
+
+    // Подсказка размера, полученная с прошлого вызова; 0, если её не было
+    size_t TakeHint() noexcept {
+        return std::exchange(coroutine_.Get().promise().hint, 0);
+    }
+
+private:
+    generator_detail::CoroutineHandle<promise_type> coroutine_;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) noexcept
+        : coroutine_(handle) {
+    }
+};
+
+/**
+ * Асинхронный генератор
+ */
+
+template <typename T>
+class AsyncGenerator {
+public:
+    struct promise_type : generator_detail::PromiseBase<T> {
+        using generator_detail::PromiseBase<T>::yield_value;
+
+        // Приёмник, ожидающий следующего значения
+        std::coroutine_handle<> consumer;
+
+        // Передаёт управление приёмнику без роста стека
+        struct ResumeConsumer {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                return handle.promise().consumer;
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        AsyncGenerator get_return_object() noexcept {
+            return AsyncGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        ResumeConsumer final_suspend() noexcept {
+            return {};
+        }
+
+        ResumeConsumer yield_value(const T& value) noexcept {
+            this->value = std::addressof(value);
+            return {};
+        }
+    };
+
+    // co_await Next() возобновляет производителя и ждёт следующего значения;
+    // результат false, если производитель завершился
+    auto Next() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> producer;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+                producer.promise().consumer = consumer;
+                return producer;
+            }
+
+            bool await_resume() const {
+                producer.promise().Rethrow();
+                return !producer.done();
+            }
+        };
+        return Awaiter{coroutine_.Get()};
+    }
+
+    const T& Value() const noexcept {
+        return *coroutine_.Get().promise().value;
+    }
+
+    size_t TakeHint() noexcept {
+        return std::exchange(coroutine_.Get().promise().hint, 0);
+    }
+
+private:
+    generator_detail::CoroutineHandle<promise_type> coroutine_;
+
+    explicit AsyncGenerator(std::coroutine_handle<promise_type> handle) noexcept
+        : coroutine_(handle) {
+    }
+};
+
+/*
+ * Сопрограмма-приёмник. Запускается сразу и продолжает работу, когда
+ * её возобновляет производитель; результат и исключение доступны после Done().
+ */
+class AppendTask {
+public:
+    struct promise_type {
+        size_t appended = 0;
+        std::exception_ptr exception;
+
+        AppendTask get_return_object() noexcept {
+            return AppendTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        void return_value(size_t count) noexcept {
+            appended = count;
+        }
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+    };
+
+    bool Done() const noexcept {
+        return coroutine_.Get().done();
+    }
+
+    // Число добавленных элементов; пробрасывает исключение производителя
+    size_t Result() const {
+        assert(Done());
+        const promise_type& promise = coroutine_.Get().promise();
+        if (promise.exception) {
+            std::rethrow_exception(promise.exception);
+        }
+        return promise.appended;
+    }
+
+private:
+    generator_detail::CoroutineHandle<promise_type> coroutine_;
+
+    explicit AppendTask(std::coroutine_handle<promise_type> handle) noexcept
+        : coroutine_(handle) {
+    }
+};
+
+/**
+ * Приёмники
+ */
+
+namespace generator_detail {
+
+template <typename T>
+void ApplyHint(Vector<T>& v, size_t hint) {
+    if (hint != 0) {
+        v.Reserve(v.Size() + hint);
+    }
+}
+
+// Дописывает кусок: тривиально копируемые элементы одним memcpy в блок AppendUninitialized
+template <typename T>
+void AppendChunk(Vector<T>& v, ConstVectorView<T> chunk) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (!chunk.Empty()) {
+            std::memcpy(v.AppendUninitialized(chunk.Size()), chunk.Data(), chunk.Size() * sizeof(T));
+        }
+    } else {
+        // Ёмкость удваивается, как в AppendUninitialized: точный резерв под каждый
+        // кусок переносил бы весь вектор на каждой выдаче
+        if (v.Size() + chunk.Size() > v.Capacity()) {
+            v.Reserve(std::max(v.Size() + chunk.Size(), v.Size() * 2));
+        }
+        for (const T& value : chunk) {
+            v.PushBack(value);
+        }
+    }
+}
+
+}  // namespace generator_detail
+
+// Дописывает в v все значения генератора и возвращает их число
+template <typename T>
+size_t AppendFrom(Vector<T>& v, Generator<T> generator) {
+    size_t appended = 0;
+    while (generator.Next()) {
+        generator_detail::ApplyHint(v, generator.TakeHint());
+        v.PushBack(generator.Value());
+        ++appended;
+    }
+    return appended;
+}
+
+// Дописывает в v все куски генератора и возвращает число добавленных элементов.
+// Подсказки размера считаются в элементах, а не в кусках
+template <typename T>
+size_t AppendChunks(Vector<T>& v, Generator<ConstVectorView<T>> generator) {
+    size_t appended = 0;
+    while (generator.Next()) {
+        generator_detail::ApplyHint(v, generator.TakeHint());
+        generator_detail::AppendChunk(v, generator.Value());
+        appended += generator.Value().Size();
+    }
+    return appended;
+}
+
+// Асинхронный вариант AppendChunks: задача приостанавливается, пока производитель ждёт
+// данных. Генератор хранится в кадре задачи, а v должен жить до её завершения
+template <typename T>
+AppendTask AppendChunksAsync(Vector<T>& v, AsyncGenerator<ConstVectorView<T>> generator) {
+    size_t appended = 0;
+    while (co_await generator.Next()) {
+        generator_detail::ApplyHint(v, generator.TakeHint());
+        generator_detail::AppendChunk(v, generator.Value());
+        appended += generator.Value().Size();
+    }
+    co_return appended;
+}
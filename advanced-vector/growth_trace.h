@@ -0,0 +1,193 @@
+#pragma once
+
+#if __cplusplus < 202002L
+#error "Vector growth tracing requires C++20 (std::source_location)"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <ostream>
+#include <source_location>
+#include <vector>
+
+/*
+ * Трассировка роста Vector по местам вызова. Каждое выделение нового буфера
+ * при росте вектора учитывается в таблице потока, из которого оно произошло:
+ * ключом служит место вызова (файл, строка, функция), значениями - число
+ * событий, выделенные байты и перенесённые элементы. Таблица потока пишется
+ * только им самим, без блокировок и атомарных read-modify-write; таблицы всех
+ * потоков собраны в список, который читается при построении отчёта.
+ * Отчёт выводится в std::cerr при завершении программы.
+ *
+ * Модуль подключается из vector.h при определённом ADVANCED_VECTOR_TRACE
+ * и сам Vector не использует, чтобы не трассировать собственные выделения.
+ */
+namespace growth_trace {
+
+// Итоги по одному месту вызова, сложенные по всем потокам
+struct SiteTotals {
+    const char* file = "";
+    const char* function = "";
+    uint32_t line = 0;
+    uint64_t events = 0;
+    uint64_t bytes = 0;
+    uint64_t relocated = 0;
+};
+
+// Печатает итоги в out; вызывается автоматически при завершении программы
+inline void WriteReport(std::ostream& out);
+
+namespace detail {
+
+// Ячейка таблицы потока. Ключ записывается один раз до публикации used с release
+struct Slot {
+    std::atomic<bool> used{false};
+    const char* file = nullptr;
+    const char* function = nullptr;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> relocated{0};
+};
+
+// Таблица с открытой адресацией. Не освобождается, чтобы пережить свой поток
+struct ThreadTable {
+    static constexpr size_t CAPACITY = 1024;
+
+    Slot slots[CAPACITY];
+    // События, не поместившиеся в переполненную таблицу
+    std::atomic<uint64_t> dropped{0};
+    ThreadTable* next = nullptr;
+};
+
+inline std::atomic<ThreadTable*>& Head() noexcept {
+    static std::atomic<ThreadTable*> head{nullptr};
+    return head;
+}
+
+// Однократно добавляет поток в список без блокировок
+inline void Register(ThreadTable* table) noexcept {
+    ThreadTable* head = Head().load(std::memory_order_relaxed);
+    do {
+        table->next = head;
+    } while (!Head().compare_exchange_weak(head, table, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Выводит отчёт при завершении программы
+struct ExitReporter {
+    ~ExitReporter() {
+        WriteReport(std::cerr);
+    }
+};
+
+inline ThreadTable* LocalTable() noexcept {
+    static ExitReporter reporter;
+    thread_local ThreadTable* table = [] {
+        ThreadTable* t = new (std::nothrow) ThreadTable;
+        if (t != nullptr) {
+            Register(t);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Счётчик пишет только поток-владелец, поэтому достаточно отдельных load и store
+inline void Add(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline bool SameSite(const Slot& slot, const std::source_location& site) noexcept {
+    return slot.line == site.line() && slot.column == site.column() && slot.file == site.file_name()
+        && slot.function == site.function_name();
+}
+
+}  // namespace detail
+
+// Учитывает выделение bytes байт с переносом relocated элементов в месте вызова site
+inline void Record(const std::source_location& site, size_t bytes, size_t relocated) noexcept {
+    detail::ThreadTable* table = detail::LocalTable();
+    if (table == nullptr) {
+        return;
+    }
+    const size_t hash = reinterpret_cast<uintptr_t>(site.file_name()) * 31 + site.line() * 131 + site.column();
+    for (size_t probe = 0; probe < detail::ThreadTable::CAPACITY; ++probe) {
+        detail::Slot& slot = table->slots[(hash + probe) % detail::ThreadTable::CAPACITY];
+        if (!slot.used.load(std::memory_order_relaxed)) {
+            slot.file = site.file_name();
+            slot.function = site.function_name();
+            slot.line = site.line();
+            slot.column = site.column();
+            slot.used.store(true, std::memory_order_release);
+        } else if (!detail::SameSite(slot, site)) {
+            continue;
+        }
+        detail::Add(slot.events, 1);
+        detail::Add(slot.bytes, bytes);
+        detail::Add(slot.relocated, relocated);
+        return;
+    }
+    detail::Add(table->dropped, 1);
+}
+
+// Итоги по всем потокам, упорядоченные по убыванию выделенных байт.
+// Одно и то же место из разных потоков и единиц трансляции сводится в одну запись
+inline std::vector<SiteTotals> Snapshot() {
+    std::vector<SiteTotals> totals;
+    for (detail::ThreadTable* table = detail::Head().load(std::memory_order_acquire); table != nullptr;
+         table = table->next) {
+        for (const detail::Slot& slot : table->slots) {
+            if (!slot.used.load(std::memory_order_acquire)) {
+                continue;
+            }
+            auto it = std::find_if(totals.begin(), totals.end(), [&slot](const SiteTotals& t) {
+                return t.line == slot.line && std::strcmp(t.file, slot.file) == 0
+                    && std::strcmp(t.function, slot.function) == 0;
+            });
+            if (it == totals.end()) {
+                it = totals.insert(totals.end(), SiteTotals{slot.file, slot.function, slot.line});
+            }
+            it->events += slot.events.load(std::memory_order_relaxed);
+            it->bytes += slot.bytes.load(std::memory_order_relaxed);
+            it->relocated += slot.relocated.load(std::memory_order_relaxed);
+        }
+    }
+    std::sort(totals.begin(), totals.end(), [](const SiteTotals& lhs, const SiteTotals& rhs) {
+        return lhs.bytes > rhs.bytes;
+    });
+    return totals;
+}
+
+// События, потерянные из-за переполнения таблиц потоков
+inline uint64_t Dropped() noexcept {
+    uint64_t dropped = 0;
+    for (detail::ThreadTable* table = detail::Head().load(std::memory_order_acquire); table != nullptr;
+         table = table->next) {
+        dropped += table->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+inline void WriteReport(std::ostream& out) {
+    const std::vector<SiteTotals> totals = Snapshot();
+    if (totals.empty()) {
+        return;
+    }
+    out << "Vector growth trace: " << totals.size() << " call sites\n";
+    out << std::setw(10) << "events" << std::setw(14) << "bytes" << std::setw(12) << "relocated" << "  site\n";
+    for (const SiteTotals& t : totals) {
+        out << std::setw(10) << t.events << std::setw(14) << t.bytes << std::setw(12) << t.relocated << "  "
+            << t.file << ':' << t.line << " (" << t.function << ")\n";
+    }
+    if (const uint64_t dropped = Dropped(); dropped != 0) {
+        out << dropped << " events dropped: per-thread table is full\n";
+    }
+}
+
+}  // namespace growth_trace
@@ -0,0 +1,212 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Очередь с приоритетом поверх Vector. Как и в std::priority_queue, на
+ * вершине лежит наибольший по Compare элемент. Хранилище доступно снаружи:
+ * его можно зарезервировать заранее, просмотреть (Values) и забрать
+ * обратно (Release), так что после прогрева операции не выделяют память.
+ *
+ * ARITY задаёт число потомков у узла. В 4-арной куче дерево вдвое ниже,
+ * а потомки узла лежат подряд в одной-двух кеш-линиях, поэтому просеивание
+ * вниз делает меньше промахов кеша ценой лишних сравнений на уровне.
+ */
+template <typename T, typename Compare = std::less<T>, size_t ARITY = 2>
+class Heap {
+    static_assert(ARITY >= 2, "Heap requires at least two children per node");
+
+public:
+    /**
+     * Конструкторы
+     */
+    explicit Heap(Compare cmp = Compare())
+        : cmp_(std::move(cmp)) {
+    }
+
+    // Превращает values в кучу за O(n) методом Флойда, не выделяя памяти
+    explicit Heap(Vector<T> values, Compare cmp = Compare())
+        : values_(std::move(values))
+        , cmp_(std::move(cmp)) {
+        Heapify();
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return values_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return values_.Size() == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return values_.Capacity();
+    }
+
+    void Reserve(size_t capacity) {
+        values_.Reserve(capacity);
+    }
+
+    const T& Top() const noexcept {
+        assert(!Empty());
+        return values_[0];
+    }
+
+    // Элементы в порядке кучи
+    ConstVectorView<T> Values() const noexcept {
+        return values_;
+    }
+
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        values_.EmplaceBack(std::forward<Args>(args)...);
+        SiftUp(values_.Size() - 1);
+    }
+
+    template <typename B>
+    void Push(B&& value) {
+        Emplace(std::forward<B>(value));
+    }
+
+    // Добавляет элементы [first, last). Большая пачка встраивается перестройкой
+    // всей кучи за O(n + k), малая - просеиванием каждого элемента вверх.
+    // Если копирование элемента бросает, куча остаётся прежней
+    template <typename InputIt>
+    void PushBatch(InputIt first, InputIt last) {
+        const size_t old_size = values_.Size();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            ReserveMore(values_, std::distance(first, last));
+        }
+        try {
+            for (; first != last; ++first) {
+                values_.EmplaceBack(*first);
+            }
+        } catch (...) {
+            // Уже добавленные элементы не просеяны: без отката куча была бы нарушена
+            while (values_.Size() > old_size) {
+                values_.PopBack();
+            }
+            throw;
+        }
+        const size_t added = values_.Size() - old_size;
+        if (added > old_size / 2) {
+            Heapify();
+        } else {
+            for (size_t i = old_size; i < values_.Size(); ++i) {
+                SiftUp(i);
+            }
+        }
+    }
+
+    // Извлекает вершину
+    T Pop() {
+        assert(!Empty());
+        T top = std::move(values_[0]);
+        const size_t last = values_.Size() - 1;
+        if (last != 0) {
+            SiftDown(0, std::move(values_[last]), last);
+        }
+        values_.PopBack();
+        return top;
+    }
+
+    // Дописывает в out до n вершин в порядке убывания приоритета; возвращает их число
+    size_t PopN(size_t n, Vector<T>& out) {
+        n = std::min(n, values_.Size());
+        ReserveMore(out, n);
+        for (size_t i = 0; i < n; ++i) {
+            out.PushBack(Pop());
+        }
+        return n;
+    }
+
+    void Clear() noexcept {
+        while (!Empty()) {
+            values_.PopBack();
+        }
+    }
+
+    // Отдаёт хранилище вместе с ёмкостью; куча остаётся пустой
+    Vector<T> Release() noexcept {
+        return std::exchange(values_, Vector<T>());
+    }
+
+private:
+    Vector<T> values_;
+    Compare cmp_;
+
+    // Резервирует место ещё под n элементов с удвоением ёмкости, чтобы
+    // повторяющиеся малые пачки не перевыделяли память при каждом вызове
+    static void ReserveMore(Vector<T>& v, size_t n) {
+        if (v.Size() + n > v.Capacity()) {
+            v.Reserve(std::max(v.Size() + n, v.Size() * 2));
+        }
+    }
+
+    static size_t Parent(size_t index) noexcept {
+        return (index - 1) / ARITY;
+    }
+
+    static size_t FirstChild(size_t index) noexcept {
+        return index * ARITY + 1;
+    }
+
+    void Heapify() {
+        const size_t size = values_.Size();
+        if (size < 2) {
+            return;
+        }
+        for (size_t i = Parent(size - 1) + 1; i-- > 0;) {
+            SiftDown(i, std::move(values_[i]), size);
+        }
+    }
+
+    // Поднимает элемент index, сдвигая предков вниз в освободившуюся ячейку
+    void SiftUp(size_t index) {
+        if (index == 0 || !cmp_(values_[Parent(index)], values_[index])) {
+            return;
+        }
+        T value = std::move(values_[index]);
+        do {
+            const size_t parent = Parent(index);
+            values_[index] = std::move(values_[parent]);
+            index = parent;
+        } while (index != 0 && cmp_(values_[Parent(index)], value));
+        values_[index] = std::move(value);
+    }
+
+    // Помещает value в дыру hole среди первых size элементов, поднимая наибольших потомков
+    void SiftDown(size_t hole, T value, size_t size) {
+        while (true) {
+            const size_t first = FirstChild(hole);
+            if (first >= size) {
+                break;
+            }
+            const size_t last = std::min(first + ARITY, size);
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (cmp_(values_[best], values_[child])) {
+                    best = child;
+                }
+            }
+            if (!cmp_(value, values_[best])) {
+                break;
+            }
+            values_[hole] = std::move(values_[best]);
+            hole = best;
+        }
+        values_[hole] = std::move(value);
+    }
+};
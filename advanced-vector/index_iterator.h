@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/*
+ * Итератор произвольного доступа по номеру элемента для контейнеров, чьи
+ * элементы лежат в памяти не одним участком (RingVector, GapVector).
+ * Разыменование обращается к operator[] контейнера Owner; для константного
+ * итератора Owner и T - константные типы.
+ */
+template <typename Owner, typename T>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    IndexIterator() = default;
+
+    IndexIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner)
+        , index_(index) {
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    pointer operator->() const noexcept {
+        return &(*owner_)[index_];
+    }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    // Номер элемента в контейнере
+    size_t Index() const noexcept {
+        return index_;
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept {
+        IndexIterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    IndexIterator operator--(int) noexcept {
+        IndexIterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    IndexIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    IndexIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator+(difference_type offset, IndexIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
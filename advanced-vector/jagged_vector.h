@@ -0,0 +1,231 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Массив строк разной длины в формате CSR: элементы всех строк лежат подряд
+ * в одном Vector, а второй Vector хранит конец каждой строки. Вместо одного
+ * выделения памяти на строку, как у Vector<Vector<T>>, - два буфера на весь
+ * массив, и обход строк подряд идёт по непрерывной памяти.
+ * Дописывать элементы можно только в последнюю строку.
+ */
+template <typename T>
+class JaggedVector {
+public:
+    /**
+     * Конструкторы
+     */
+    JaggedVector() = default;
+
+    // Собирает массив из вложенных векторов за один проход по элементам
+    explicit JaggedVector(const Vector<Vector<T>>& rows) {
+        ReserveFor(rows);
+        for (const Vector<T>& row : rows) {
+            AppendRow(ConstVectorView<T>(row));
+        }
+    }
+
+    explicit JaggedVector(Vector<Vector<T>>&& rows) {
+        ReserveFor(rows);
+        for (Vector<T>& row : rows) {
+            AppendRow(std::make_move_iterator(row.begin()), std::make_move_iterator(row.end()));
+        }
+    }
+
+    /**
+     * Операторы
+     */
+
+    VectorView<T> operator[](size_t row) noexcept {
+        return Row(row);
+    }
+
+    ConstVectorView<T> operator[](size_t row) const noexcept {
+        return Row(row);
+    }
+
+    /**
+     * Методы
+     */
+
+    void Swap(JaggedVector& other) noexcept {
+        values_.Swap(other.values_);
+        row_ends_.Swap(other.row_ends_);
+    }
+
+    size_t RowCount() const noexcept {
+        return row_ends_.Size();
+    }
+
+    // Общее число элементов во всех строках
+    size_t Size() const noexcept {
+        return values_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return row_ends_.Size() == 0;
+    }
+
+    size_t RowSize(size_t row) const noexcept {
+        assert(row < row_ends_.Size());
+        return row_ends_[row] - RowBegin(row);
+    }
+
+    VectorView<T> Row(size_t row) noexcept {
+        assert(row < row_ends_.Size());
+        return VectorView<T>(values_.begin() + RowBegin(row), RowSize(row));
+    }
+
+    ConstVectorView<T> Row(size_t row) const noexcept {
+        return const_cast<JaggedVector&>(*this).Row(row);
+    }
+
+    // Элементы всех строк подряд
+    VectorView<T> Values() noexcept {
+        return values_;
+    }
+
+    ConstVectorView<T> Values() const noexcept {
+        return values_;
+    }
+
+    // Конец каждой строки в Values(); строка row начинается там, где кончается row - 1
+    ConstVectorView<size_t> RowEnds() const noexcept {
+        return row_ends_;
+    }
+
+    void Reserve(size_t rows, size_t values) {
+        row_ends_.Reserve(rows);
+        values_.Reserve(values);
+    }
+
+    // Начинает новую пустую строку
+    void AppendRow() {
+        row_ends_.PushBack(values_.Size());
+    }
+
+    // Добавляет строку из элементов [first, last). Указатели могут ссылаться
+    // на элементы этого же массива (например, чтобы повторить строку)
+    template <typename InputIt>
+    void AppendRow(InputIt first, InputIt last) {
+        if constexpr (std::is_pointer_v<InputIt>
+                      && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>) {
+            AppendCopy(first, last - first);
+        } else {
+            const size_t old_size = values_.Size();
+            try {
+                if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                                typename std::iterator_traits<InputIt>::iterator_category>) {
+                    ReserveValues(std::distance(first, last));
+                }
+                for (; first != last; ++first) {
+                    values_.EmplaceBack(*first);
+                }
+                row_ends_.PushBack(values_.Size());
+            } catch (...) {
+                Truncate(old_size);
+                throw;
+            }
+        }
+    }
+
+    void AppendRow(ConstVectorView<T> row) {
+        AppendCopy(row.Data(), row.Size());
+    }
+
+    // Дописывает элемент в последнюю строку
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        assert(!Empty());
+        T& result = values_.EmplaceBack(std::forward<Args>(args)...);
+        ++row_ends_[row_ends_.Size() - 1];
+        return result;
+    }
+
+    template <typename B>
+    void PushBack(B&& value) {
+        EmplaceBack(std::forward<B>(value));
+    }
+
+    // Удаляет последнюю строку вместе с её элементами
+    void PopRow() {
+        assert(!Empty());
+        Truncate(RowBegin(row_ends_.Size() - 1));
+        row_ends_.PopBack();
+    }
+
+    void Clear() noexcept {
+        Truncate(0);
+        row_ends_.Resize(0);
+    }
+
+private:
+    Vector<T> values_;
+    Vector<size_t> row_ends_;
+
+    // Resize требовал бы конструктора по умолчанию даже для уменьшения
+    void Truncate(size_t size) noexcept {
+        while (values_.Size() > size) {
+            values_.PopBack();
+        }
+    }
+
+    // Резервирует место ещё под n элементов с удвоением ёмкости, как AppendUninitialized
+    void ReserveValues(size_t n) {
+        if (values_.Size() + n > values_.Capacity()) {
+            values_.Reserve(std::max(values_.Size() + n, values_.Size() * 2));
+        }
+    }
+
+    // Копирует строку [data, data + n). Если она лежит в values_, её адрес
+    // пересчитывается после резервирования, которое могло перенести буфер
+    void AppendCopy(const T* data, size_t n) {
+        const size_t old_size = values_.Size();
+        const std::less<const T*> before;
+        const bool aliased = n != 0 && !before(data, values_.begin()) && before(data, values_.end());
+        const size_t offset = aliased ? data - values_.begin() : 0;
+        if (row_ends_.Size() == row_ends_.Capacity()) {
+            row_ends_.Reserve(std::max<size_t>(row_ends_.Size() * 2, 1));
+        }
+        ReserveValues(n);
+        if (aliased) {
+            data = values_.begin() + offset;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n != 0) {
+                std::memcpy(values_.AppendUninitialized(n), data, n * sizeof(T));
+            }
+        } else {
+            // Места хватает, поэтому EmplaceBack не переносит буфер и data остаётся действительным
+            try {
+                for (size_t i = 0; i < n; ++i) {
+                    values_.EmplaceBack(data[i]);
+                }
+            } catch (...) {
+                Truncate(old_size);
+                throw;
+            }
+        }
+        row_ends_.PushBack(values_.Size());
+    }
+
+    size_t RowBegin(size_t row) const noexcept {
+        return row == 0 ? 0 : row_ends_[row - 1];
+    }
+
+    void ReserveFor(const Vector<Vector<T>>& rows) {
+        size_t total = 0;
+        for (const Vector<T>& row : rows) {
+            total += row.Size();
+        }
+        Reserve(rows.Size(), total);
+    }
+};
@@ -1,9 +1,35 @@
 #include "vector.h"
+#include "bit_vector.h"
+#include "compressed_int_vector.h"
+#include "concurrent_queue.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#if __cplusplus >= 202002L
+#include "generator.h"
+#endif
+#include "gap_vector.h"
+#include "heap.h"
+#include "jagged_vector.h"
+#include "mmap_vector.h"
+#include "ring_vector.h"
+#include "set_algorithms.h"
+#include "shm_vector.h"
+#include "slot_map.h"
+#include "sort.h"
+#include "vector_algorithms.h"
+#include "vector_io.h"
+#include "vector_view.h"
 
+#include <filesystem>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace {
 
@@ -558,84 +584,1676 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 200;
+    {
+        BitVector v;
+        assert(v.Size() == 0);
+        assert(v.Count() == 0);
+        assert(v.FindFirst() == BitVector::NPOS);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i % 3 == 0);
+        }
+        assert(v.Size() == SIZE);
+        assert(v.WordCount() == 4);
+        assert(v.Count() == 67);
+        assert(v[0] && !v[1] && v[198]);
+        assert(v.FindFirst() == 0);
+        assert(v.FindNext(0) == 3);
+        assert(v.FindNext(198) == BitVector::NPOS);
+
+        v[1] = true;
+        v[0].Flip();
+        assert(!v[0] && v[1]);
+        v[2] = v[1];
+        assert(v[2]);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    {
+        BitVector v(SIZE);
+        v[63] = true;
+        v[64] = true;
+        v[SIZE - 1] = true;
+        v.Erase(10);
+        assert(v.Size() == SIZE - 1);
+        assert(v[62] && v[63] && !v[64]);
+        assert(v[SIZE - 2]);
+        assert(v.Count() == 3);
+        v.Erase(v.Size() - 1);
+        assert(v.Count() == 2);
+        while (v.Size() > 64) {
+            v.PopBack();
+        }
+        assert(v.WordCount() == 1);
+        assert(v.Count() == 2);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    {
+        BitVector v(70, true);
+        assert(v.Count() == 70);
+        v.Resize(10);
+        assert(v.Count() == 10);
+        v.Resize(130, true);
+        assert(v.Count() == 130);
+        v.Resize(140);
+        assert(v.Count() == 130 && !v[135]);
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    {
+        BitVector a(SIZE);
+        BitVector b(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            a[i] = i % 2 == 0;
+            b[i] = i % 4 == 0;
         }
-        return *this;
+        BitVector c = a;
+        c &= b;
+        assert(c.Count() == 50);
+        c = a;
+        c |= b;
+        assert(c.Count() == 100);
+        c ^= b;
+        assert(c.Count() == 50 && c.FindFirst() == 2);
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+}
+
+void Test8() {
+    const size_t SIZE = 1003;
+    {
+        Vector<int32_t> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int32_t>(i % 100) - 50);
+        }
+        v[700] = 1000;
+        v[901] = -1000;
+        assert(Find(v, 1000) == &v[700]);
+        assert(Find(v, 12345) == v.end());
+        assert(Count(v, 7) == 10);
+        assert(Count(v, 1000) == 1);
+        assert(MinMax(v) == std::make_pair(-1000, 1000));
+
+        int64_t sum = 0;
+        int64_t dot = 0;
+        for (int32_t x : v) {
+            sum += x;
+            dot += static_cast<int64_t>(x) * x;
+        }
+        assert(Sum(v) == sum);
+        assert(Dot(v, v) == dot);
     }
-    ~C() {
-        ++dtor;
+    {
+        Vector<int32_t> v(5);
+        v[3] = -7;
+        assert(MinMax(v) == std::make_pair(-7, 0));
+        assert(Find(v, -7) == &v[3]);
+        assert(Sum(v) == -7);
     }
+    {
+        Vector<float> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i % 8));
+        }
+        v[SIZE - 1] = -2.5f;
+        assert(Find(v, 7.0f) == &v[7]);
+        assert(Find(v, -2.5f) == &v[SIZE - 1]);
+        assert(Count(v, 3.0f) == 125);
+        assert(MinMax(v) == std::make_pair(-2.5f, 7.0f));
+        assert(Sum(v) == 3498.5f);
+        assert(Dot(v, v) == 17507.25f);
+    }
+    {
+        Vector<uint64_t> v(SIZE);
+        v[SIZE / 2] = 5;
+        assert(Count(v, uint64_t{0}) == SIZE - 1);
+        assert(Sum(v) == 5);
+        assert(MinMax(v) == std::make_pair(uint64_t{0}, uint64_t{5}));
+    }
+}
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+void Test9() {
+    struct Point {
+        int x;
+        double y;
+    };
+    const size_t SIZE = 1000;
+    Vector<Point> v;
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(Point{static_cast<int>(i), i * 0.5});
     }
+    v.Insert(v.cbegin() + 1, Point{-1, -1.0});
+    assert(v.Size() == SIZE + 1);
+    assert(v[1].x == -1 && v[2].x == 1 && v[SIZE].x == static_cast<int>(SIZE - 1));
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+    Vector<Point> copy(v);
+    assert(copy.Size() == v.Size());
+    assert(&copy[0] != &v[0]);
+    assert(copy[SIZE].y == v[SIZE].y);
+
+    Vector<Point> small(10);
+    small.Reserve(SIZE * 4);
+    small = v;
+    assert(small.Size() == SIZE + 1);
+    assert(small.Capacity() == SIZE * 4);
+    assert(small[SIZE].x == static_cast<int>(SIZE - 1));
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+    Vector<Point> empty;
+    small = empty;
+    assert(small.Size() == 0);
+    small.Reserve(SIZE * 8);
+    assert(small.Size() == 0);
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
+void Test10() {
+    using namespace std::literals;
+    {
+        FlatSet<int> s;
+        assert(s.Empty());
+        assert(s.Insert(5).second);
+        assert(s.Insert(1).second);
+        assert(s.Insert(3).second);
+        assert(!s.Insert(3).second);
+        assert(s.Size() == 3);
+        assert(std::is_sorted(s.begin(), s.end()));
+        assert(s.Contains(1) && !s.Contains(2));
+        assert(*s.LowerBound(2) == 3);
+        assert(s.LowerBound(6) == s.end());
+
+        const int batch[] = {9, 2, 5, 9, 0};
+        s.InsertBatch(std::begin(batch), std::end(batch));
+        assert(s.Size() == 6);
+        assert(std::is_sorted(s.begin(), s.end()));
+        assert(std::adjacent_find(s.begin(), s.end()) == s.end());
+
+        assert(s.Erase(5));
+        assert(!s.Erase(5));
+        assert(s.Size() == 5 && !s.Contains(5));
+    }
+    {
+        // Сравнение, бросившее посреди пакетной вставки, не портит множество
+        struct ThrowingLess {
+            int* budget;
+            bool operator()(int lhs, int rhs) const {
+                if (*budget >= 0 && (*budget)-- == 0) {
+                    throw std::runtime_error("compare failed");
+                }
+                return lhs < rhs;
+            }
+        };
+        int budget = -1;
+        FlatSet<int, ThrowingLess> s(ThrowingLess{&budget});
+        for (int i = 0; i < 20; i += 2) {
+            s.Insert(i);
+        }
+        const int batch[] = {7, 3, 30, 2, 11, 3};
+        for (int failure = 0;; ++failure) {
+            budget = failure;
+            try {
+                s.InsertBatch(std::begin(batch), std::end(batch));
+                break;
+            } catch (const std::runtime_error&) {
+                budget = -1;
+                assert(s.Size() == 10 && std::is_sorted(s.begin(), s.end()));
+                assert(std::adjacent_find(s.begin(), s.end()) == s.end());
+            }
+        }
+        budget = -1;
+        assert(s.Size() == 14 && std::is_sorted(s.begin(), s.end()) && s.Contains(30) && s.Contains(3));
+    }
+    {
+        FlatSet<int, std::greater<int>> s;
+        for (int i = 0; i < 100; ++i) {
+            s.Insert(i * 37 % 100);
+        }
+        assert(s.Size() == 100);
+        assert(*s.begin() == 99);
+        for (int i = 0; i < 100; ++i) {
+            assert(s.Find(i) != s.end() && *s.Find(i) == i);
+        }
+    }
+    {
+        FlatMap<int, std::string> m;
+        assert(m.Insert(2, "two"s).second);
+        assert(m.Insert(1, "one"s).second);
+        assert(!m.Insert(1, "uno"s).second);
+        m[3] = "three"s;
+        assert(m.Size() == 3);
+        assert(*m.Find(1) == "one"s);
+        assert(m.Find(4) == nullptr);
+        assert(m.KeyAt(2) == 3 && m.ValueAt(2) == "three"s);
+
+        Vector<std::pair<int, std::string>> batch;
+        batch.PushBack(std::make_pair(5, "five"s));
+        batch.PushBack(std::make_pair(2, "deux"s));
+        batch.PushBack(std::make_pair(0, "zero"s));
+        batch.PushBack(std::make_pair(5, "cinq"s));
+        m.InsertBatch(std::move(batch));
+        assert(m.Size() == 5);
+        assert(std::is_sorted(m.Keys().begin(), m.Keys().end()));
+        assert(*m.Find(2) == "two"s);
+        assert(*m.Find(5) == "five"s);
+        assert(*m.Find(0) == "zero"s);
+
+        assert(m.Erase(2));
+        assert(!m.Contains(2));
+        assert(m.Keys().Size() == m.Values().Size());
+    }
+    {
+        Obj::ResetCounters();
         {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+            FlatMap<int, Obj> m;
+            m.TryEmplace(1, 1);
+            m.TryEmplace(2, 2);
+            Obj::default_construction_throw_countdown = 1;
+            try {
+                m[0];
+                assert(false && "Exception is expected");
+            } catch (const std::runtime_error&) {
+            }
+            assert(m.Size() == 2);
+            assert(!m.Contains(0));
+            assert(m.Keys().Size() == m.Values().Size());
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test11() {
+    struct Record {
+        uint32_t id;
+        float weight;
+        char tag[4];
+    };
+    const size_t SIZE = 1001;
+    const uint64_t TAG = 7;
+    Vector<Record> v;
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(Record{static_cast<uint32_t>(i), i * 0.25f, {'a', 'b', 'c', 'd'}});
+    }
+    {
+        std::stringstream stream;
+        Save(stream, v, TAG);
+        Vector<Record> loaded = Load<Record>(stream, TAG);
+        assert(loaded.Size() == SIZE);
+        assert(loaded.Capacity() == SIZE);
+        assert(loaded[SIZE - 1].id == SIZE - 1);
+        assert(loaded[SIZE - 1].weight == (SIZE - 1) * 0.25f);
+        assert(loaded[3].tag[3] == 'd');
+    }
+    {
+        std::stringstream stream;
+        Save(stream, Vector<Record>{}, TAG);
+        assert(Load<Record>(stream, TAG).Size() == 0);
+    }
+    {
+        std::stringstream stream;
+        Save(stream, v, TAG);
+        try {
+            Load<Record>(stream, TAG + 1);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+    }
+    {
+        std::stringstream stream;
+        Save(stream, v, TAG);
+        std::string bytes = stream.str();
+        bytes[bytes.size() - 1] ^= 1;
+        std::stringstream corrupted(bytes);
+        try {
+            Load<Record>(corrupted, TAG);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+        try {
+            Load<Record>(truncated, TAG);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+    }
+    {
+        // Заголовок обещает огромный вектор: ошибка обнаруживается до выделения памяти
+        std::stringstream stream;
+        Save(stream, v, TAG);
+        std::string bytes = stream.str().substr(0, sizeof(VectorFileHeader));
+        const uint64_t count = std::numeric_limits<uint64_t>::max() / sizeof(Record);
+        std::memcpy(bytes.data() + offsetof(VectorFileHeader, count), &count, sizeof(count));
+        std::stringstream lying(bytes);
+        try {
+            Load<Record>(lying, TAG);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+
+        // Непозиционируемый поток читается частями
+        struct SequentialBuffer : std::streambuf {
+            explicit SequentialBuffer(std::string& data) {
+                setg(data.data(), data.data(), data.data() + data.size());
+            }
+        };
+        SequentialBuffer lying_buffer(bytes);
+        std::istream sequential_lying(&lying_buffer);
+        try {
+            Load<Record>(sequential_lying, TAG);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        std::stringstream full;
+        Save(full, v, TAG);
+        std::string full_bytes = full.str();
+        SequentialBuffer buffer(full_bytes);
+        std::istream sequential(&buffer);
+        Vector<Record> loaded = Load<Record>(sequential, TAG);
+        assert(loaded.Size() == SIZE && loaded[SIZE - 1].id == SIZE - 1);
+    }
+}
+
+void Test12() {
+    const size_t SIZE = 10'000;
+    const std::string path = (std::filesystem::temp_directory_path() / "advanced_vector_test.mmap").string();
+    std::filesystem::remove(path);
+    {
+        MmapVector<uint64_t> v(path);
+        assert(v.Size() == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i * i);
+        }
+        v.EmplaceBack(v[1]);
+        assert(v.Size() == SIZE + 1);
+        assert(v.Capacity() >= v.Size());
+        assert(v[SIZE] == 1);
+        v.PopBack();
+        v.Sync();
+    }
+    assert(std::filesystem::file_size(path) >= SIZE * sizeof(uint64_t));
+    {
+        MmapVector<uint64_t> v(path);
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == (SIZE - 1) * (SIZE - 1));
+        assert(std::distance(v.begin(), v.end()) == static_cast<std::ptrdiff_t>(SIZE));
+        v.Resize(10);
+        v.Resize(20);
+        assert(v[9] == 81 && v[10] == 0);
+
+        MmapVector<uint64_t> moved(std::move(v));
+        assert(moved.Size() == 20);
+        // Перемещённый вектор пуст и не связан с файлом
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.begin() == v.end());
+        v.PopBack();
+        v.Resize(0);
+        v.Sync();
+        try {
+            v.PushBack(1);
+            assert(false && "Exception is expected");
+        } catch (const std::logic_error&) {
         }
-        Dump();
-    } catch (...) {
     }
     try {
-        const size_t NUM = 10;
-        C c;
+        MmapVector<uint32_t> wrong_type(path);
+        assert(false && "Exception is expected");
+    } catch (const std::runtime_error&) {
+    }
+    std::filesystem::remove(path);
+}
+
+void Test13() {
+    const size_t SIZE = 16;
+    {
+        int external[SIZE];
+        for (size_t i = 0; i < SIZE; ++i) {
+            external[i] = static_cast<int>(i);
+        }
+        VectorView<int> view(external, SIZE);
+        assert(view.Size() == SIZE);
+        view[3] = 42;
+        assert(external[3] == 42);
+        ConstVectorView<int> const_view = view;
+        assert(const_view[3] == 42);
+        assert(std::distance(const_view.begin(), const_view.end()) == static_cast<std::ptrdiff_t>(SIZE));
+        ConstVectorView<int> tail = const_view.SubView(SIZE - 4, 4);
+        assert(tail.Size() == 4 && tail[0] == static_cast<int>(SIZE - 4));
+    }
+    {
+        Vector<int> v(SIZE);
+        const Vector<int>& cv = v;
+        VectorView<int> view = v;
+        ConstVectorView<int> const_view = cv;
+        view[1] = 7;
+        assert(const_view[1] == 7);
+        assert(const_view.Data() == &v[0]);
+        assert(Sum(v) == 7);
+    }
+    {
+        int released = 0;
+        auto* buffer = static_cast<Obj*>(std::malloc(sizeof(Obj) * SIZE));
+        Obj::ResetCounters();
+        for (size_t i = 0; i < SIZE; ++i) {
+            new (buffer + i) Obj(static_cast<int>(i));
+        }
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            Vector<Obj> v(buffer, SIZE, [&released](Obj* data) {
+                ++released;
+                std::free(data);
+            });
+            assert(v.Size() == SIZE);
+            assert(v.Capacity() == SIZE);
+            assert(&v[0] == buffer);
+            assert(v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+            Vector<Obj> moved(std::move(v));
+            assert(released == 0);
+            moved.PushBack(Obj{-1});
+            assert(released == 1);
+            assert(moved.Size() == SIZE + 1);
+            assert(moved[5].id == 5);
+        }
+        assert(released == 1);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        int released = 0;
+        {
+            Vector<int> v(new int[SIZE](), SIZE, [&released](int* data) {
+                ++released;
+                delete[] data;
+            });
+            v[0] = 1;
+        }
+        assert(released == 1);
+    }
+    {
+        // Не удалось принять буфер: элементы разрушаются до освобождения памяти
+        struct FailingDeleter {
+            int* moves;
+            int* released;
+            FailingDeleter(int* moves, int* released)
+                : moves(moves)
+                , released(released) {
+            }
+            FailingDeleter(FailingDeleter&& other)
+                : moves(other.moves)
+                , released(other.released) {
+                if (++*moves == 2) {
+                    throw std::runtime_error("move failed");
+                }
+            }
+            void operator()(Obj* data) const {
+                assert(Obj::GetAliveObjectCount() == 0);
+                ++*released;
+                std::free(data);
+            }
+        };
+        int moves = 0;
+        int released = 0;
+        auto* buffer = static_cast<Obj*>(std::malloc(sizeof(Obj) * SIZE));
+        Obj::ResetCounters();
+        for (size_t i = 0; i < SIZE; ++i) {
+            new (buffer + i) Obj(static_cast<int>(i));
+        }
+        try {
+            Vector<Obj> v(buffer, SIZE, FailingDeleter(&moves, &released));
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(released == 1);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 10'000;
+    {
+        CompressedIntVector v;
+        assert(v.Size() == 0);
+        assert(v.LowerBound(5) == 0);
+        Vector<uint64_t> expected;
+        uint64_t value = 1'000'000;
+        for (size_t i = 0; i < SIZE; ++i) {
+            value += i % 7 + (i % 1000 == 0 ? 100'000 : 0);
+            v.PushBack(value);
+            expected.PushBack(value);
+        }
+        assert(v.Size() == SIZE);
+        assert(v.BlockCount() == (SIZE + CompressedIntVector::BLOCK_SIZE - 1) / CompressedIntVector::BLOCK_SIZE);
+        for (size_t i = 0; i < SIZE; i += 13) {
+            assert(v[i] == expected[i]);
+        }
+        assert(v[SIZE - 1] == expected[SIZE - 1]);
+
+        size_t index = 0;
+        v.ForEach([&](uint64_t x) {
+            assert(x == expected[index++]);
+        });
+        assert(index == SIZE);
+
+        const Vector<uint64_t> decoded = v.Decode();
+        assert(decoded.Size() == SIZE);
+        assert(std::equal(decoded.begin(), decoded.end(), expected.begin()));
+
+        for (size_t i = 0; i < SIZE; i += 97) {
+            assert(v.LowerBound(expected[i]) == static_cast<size_t>(std::lower_bound(expected.begin(), expected.end(), expected[i]) - expected.begin()));
+            assert(v.LowerBound(expected[i] + 1) == static_cast<size_t>(std::upper_bound(expected.begin(), expected.end(), expected[i]) - expected.begin()));
+        }
+        assert(v.LowerBound(0) == 0);
+        assert(v.LowerBound(expected[SIZE - 1] + 1) == SIZE);
+        assert(v.MemoryUsage() * 4 < SIZE * sizeof(uint64_t));
+
+        try {
+            v.PushBack(0);
+            assert(false && "Exception is expected");
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    {
+        CompressedIntVector v;
+        for (size_t i = 0; i < 300; ++i) {
+            v.PushBack(i < 150 ? i : (uint64_t{1} << 63) + i);
+        }
+        v.PushBack(~uint64_t{0});
+        assert(v[0] == 0 && v[149] == 149);
+        assert(v[150] == (uint64_t{1} << 63) + 150);
+        assert(v[299] == (uint64_t{1} << 63) + 299);
+        assert(v[300] == ~uint64_t{0});
+    }
+    {
+        // Блок с постоянным шагом хранится без слов данных
+        CompressedIntVector v;
+        for (size_t i = 0; i < CompressedIntVector::BLOCK_SIZE; ++i) {
+            v.PushBack(7 + 3 * i);
+        }
+        assert(v.BlockCount() == 1);
+        for (size_t i = 0; i < CompressedIntVector::BLOCK_SIZE; ++i) {
+            assert(v[i] == 7 + 3 * i);
+        }
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 5000;
+    const std::string name = "/advanced_vector_test_" + std::to_string(::getpid());
+    {
+        MmapVector<uint32_t> writer = CreateSharedVector<uint32_t>(name);
+        for (size_t i = 0; i < SIZE; ++i) {
+            writer.PushBack(static_cast<uint32_t>(i));
+        }
+
+        SharedVectorReader<uint32_t> reader(name);
+        assert(reader.Size() == SIZE);
+        assert(reader[SIZE - 1] == SIZE - 1);
+        assert(&reader[0] != &writer[0]);
+
+        // Читатель в другом процессе видит те же данные
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            SharedVectorReader<uint32_t> child_reader(name);
+            const ConstVectorView<uint32_t> view = child_reader.View();
+            uint64_t sum = 0;
+            for (uint32_t x : view) {
+                sum += x;
+            }
+            ::_exit(view.Size() == SIZE && sum == SIZE * (SIZE - 1) / 2 ? 0 : 1);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        writer.Reserve(SIZE * 4);
+        for (size_t i = SIZE; i < SIZE * 3; ++i) {
+            writer.PushBack(static_cast<uint32_t>(i));
+        }
+        assert(reader.Size() <= SIZE * 3);
+        reader.Refresh();
+        assert(reader.Size() == SIZE * 3);
+        assert(reader[SIZE * 3 - 1] == SIZE * 3 - 1);
+        assert(std::equal(reader.begin(), reader.end(), writer.begin()));
+
+        SharedVectorReader<uint32_t> moved(std::move(reader));
+        assert(moved.Size() == SIZE * 3);
+        assert(reader.Size() == 0 && reader.begin() == reader.end() && reader.View().Empty());
+    }
+    RemoveSharedVector(name);
+    try {
+        SharedVectorReader<uint32_t> missing(name);
+        assert(false && "Exception is expected");
+    } catch (const std::system_error&) {
+    }
+}
+
+void Test16() {
+    if constexpr (!VectorStats::ENABLED) {
+        assert(Vector<int>(10).Stats().allocations == 0);
+        return;
+    }
+    {
+        Vector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        const VectorStats stats = v.Stats();
+        assert(stats.allocations == 8);
+        assert(stats.reallocations == 7);
+        assert(stats.bytes_allocated == (1 + 2 + 4 + 8 + 16 + 32 + 64 + 128) * sizeof(int));
+        assert(stats.elements_moved == 127);
+        assert(stats.elements_copied == 0);
+        assert(stats.peak_capacity == 128);
+        assert(stats.wasted_capacity == 28);
+
+        Vector<int> copy(v);
+        assert(copy.Stats().allocations == 1);
+        assert(copy.Stats().reallocations == 0);
+    }
+    {
+        struct CopyOnly {
+            CopyOnly() = default;
+            CopyOnly(const CopyOnly&) = default;
+            ~CopyOnly() {
+            }
+            std::string s;
+        };
+        Vector<CopyOnly> v(10);
+        v.Reserve(20);
+        v.Insert(v.cbegin(), CopyOnly{});
+        v.Resize(21);
+        v.EmplaceBack();
+        const VectorStats stats = v.Stats();
+        assert(stats.allocations == 4);
+        assert(stats.reallocations == 3);
+        assert(stats.elements_copied == 10 + 11 + 21);
+        assert(stats.elements_moved == 0);
+        assert(stats.peak_capacity == 42);
+
+        Vector<CopyOnly> small;
+        small = v;
+        assert(small.Stats().allocations == 1);
+    }
+}
+
+void Test17() {
+#ifdef ADVANCED_VECTOR_TRACE
+    auto find_site = [](uint32_t line) {
+        for (const growth_trace::SiteTotals& totals : growth_trace::Snapshot()) {
+            if (totals.line == line && std::string_view(totals.file).find("main.cpp") != std::string_view::npos) {
+                return totals;
+            }
+        }
+        return growth_trace::SiteTotals{};
+    };
+    {
+        // Рост из двух потоков в одном месте вызова сводится в одну запись
+        const std::source_location site = std::source_location::current();
+        auto fill = [&site] {
+            Vector<int> v;
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i, site);
+            }
+        };
+        fill();
+        std::thread(fill).join();
+        const growth_trace::SiteTotals totals = find_site(site.line());
+        assert(totals.events == 2 * 8);
+        assert(totals.bytes == 2 * (1 + 2 + 4 + 8 + 16 + 32 + 64 + 128) * sizeof(int));
+        assert(totals.relocated == 2 * 127);
+    }
+    {
+        // EmplaceBack приписывается месту конструирования вектора
+        const uint32_t line = std::source_location::current().line() + 1;
+        Vector<std::string> v;
+        v.EmplaceBack("a");
+        v.EmplaceBack("b");
+        const growth_trace::SiteTotals totals = find_site(line);
+        assert(totals.events == 2);
+        assert(totals.relocated == 1);
+    }
+    {
+        const uint32_t line = std::source_location::current().line() + 1;
+        Vector<int> v(4);
+        v.Reserve(10);
+        assert(find_site(line).events == 0);
+        assert(find_site(line + 1).events == 1);
+        assert(find_site(line + 1).bytes == 10 * sizeof(int));
+        assert(find_site(line + 1).relocated == 4);
+    }
+#endif
+}
+
+void Test18() {
+    static_assert(!std::is_convertible_v<VectorCallSite, Vector<int>>);
+    {
+        // Конструктор по умолчанию остаётся неявным
+        std::pair<Vector<int>, Vector<int>> pair = {};
+        Vector<int> v = {};
+        assert(pair.first.Size() == 0 && v.Size() == 0);
+    }
+#ifdef ADVANCED_VECTOR_ADAPTIVE_CAPACITY
+    const std::source_location site = std::source_location::current();
+    auto fill = [&site](int n) {
+        Vector<int> v(site);
+        for (int i = 0; i < n; ++i) {
+            v.PushBack(i);
+        }
+        return v.Capacity();
+    };
+    // Пока наблюдений мало, рост идёт по обычной цепочке удвоений
+    for (uint64_t i = 0; i < capacity_hints::MIN_SAMPLES; ++i) {
+        assert(fill(100) == 128);
+    }
+    assert(capacity_hints::Hint(site) == 128);
+    {
+        Vector<int> v(site);
+        v.PushBack(1);
+        assert(v.Capacity() == 128);
+    }
+    // Подсказка покрывает 90% предшественников, редкие большие вектора на неё не влияют
+    assert(fill(1000) == 1024);
+    assert(capacity_hints::Hint(site) == 128);
+
+    // Перемещённый вектор учитывается один раз, под местом своего конструирования
+    const std::source_location moved_site = std::source_location::current();
+    for (uint64_t i = 0; i < capacity_hints::MIN_SAMPLES; ++i) {
+        Vector<int> v(moved_site);
+        v.Resize(30);
+        Vector<int> target(std::move(v));
+        Vector<int> assigned;
+        assigned = std::move(target);
+    }
+    assert(capacity_hints::Hint(moved_site) == 32);
+
+    // Копирующее присваивание оставляет вектору его место конструирования
+    const std::source_location assigned_site = std::source_location::current();
+    Vector<int> source(60);
+    for (uint64_t i = 0; i < capacity_hints::MIN_SAMPLES; ++i) {
+        Vector<int> assigned(assigned_site);
+        assigned = source;
+    }
+    assert(capacity_hints::Hint(assigned_site) == 64);
+#endif
+}
+
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+// Таблица CRC-32, построенная во время компиляции
+constexpr Vector<uint32_t> MakeCrc32Table() {
+    Vector<uint32_t> table;
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        table.PushBack(crc);
+    }
+    return table;
+}
+
+constexpr auto CRC32_TABLE = MaterializeVector([] {
+    return MakeCrc32Table();
+});
+static_assert(CRC32_TABLE.size() == 256);
+static_assert(CRC32_TABLE[1] == 0x77073096u && CRC32_TABLE[255] == 0x2D02EF8Du);
+
+constexpr bool ConstexprVectorOperations() {
+    Vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.EmplaceBack(i);
+    }
+    v.Insert(v.cbegin(), -1);
+    v.Erase(v.cbegin() + 3);
+    v.PopBack();
+    Vector<int> copy(v);
+    copy.Resize(20);
+    copy.Reserve(40);
+    v = copy;
+    Vector<int> moved(std::move(copy));
+    if (v.Size() != 20 || moved.Size() != 20 || copy.Size() != 0 || v[0] != -1 || v[3] != 3 || v[19] != 0) {
+        return false;
+    }
+
+    // Элементы с нетривиальными конструкторами и деструкторами
+    Vector<Vector<int>> nested;
+    for (int i = 0; i < 5; ++i) {
+        nested.EmplaceBack(static_cast<size_t>(i));
+    }
+    nested.Insert(nested.cbegin() + 1, Vector<int>(7));
+    nested.Erase(nested.cbegin());
+    return nested.Size() == 5 && nested[0].Size() == 7 && nested[4].Size() == 4;
+}
+static_assert(ConstexprVectorOperations());
+#endif
+
+void Test19() {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    // Таблица уже лежит в статической памяти и совпадает с вычисленной во время работы
+    const Vector<uint32_t> runtime = MakeCrc32Table();
+    assert(std::equal(runtime.begin(), runtime.end(), CRC32_TABLE.begin(), CRC32_TABLE.end()));
+    assert(ConstexprVectorOperations());
+#endif
+}
+
+#if __cplusplus >= 202002L
+Generator<int> Squares(int n) {
+    co_yield SizeHint{static_cast<size_t>(n)};
+    for (int i = 0; i < n; ++i) {
+        co_yield i * i;
+    }
+}
+
+// Разбирает текст кусками фиксированного размера, переиспользуя один буфер
+Generator<ConstVectorView<int>> ParseChunks(std::string text, size_t chunk_size) {
+    co_yield SizeHint{static_cast<size_t>(std::count(text.begin(), text.end(), ' ') + 1)};
+    Vector<int> buffer;
+    std::istringstream in(text);
+    for (int value; in >> value;) {
+        buffer.PushBack(value);
+        if (buffer.Size() == chunk_size) {
+            co_yield ConstVectorView<int>(buffer);
+            buffer.Resize(0);
+        }
+    }
+    if (buffer.Size() != 0) {
+        co_yield ConstVectorView<int>(buffer);
+    }
+}
+
+// Куски строк без подсказки размера
+Generator<ConstVectorView<std::string>> StringChunks(int chunks) {
+    Vector<std::string> buffer(2);
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        buffer[0] = std::to_string(chunk);
+        buffer[1] = std::to_string(-chunk);
+        co_yield ConstVectorView<std::string>(buffer);
+    }
+}
+
+// Событие, которое возобновляет ожидающую сопрограмму, как завершение ввода-вывода
+struct ManualEvent {
+    std::coroutine_handle<> waiter;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        waiter = handle;
+    }
+    void await_resume() const noexcept {
+    }
+    void Fire() {
+        std::exchange(waiter, {}).resume();
+    }
+};
+
+AsyncGenerator<ConstVectorView<int>> ReadChunksAsync(ManualEvent& ready, int chunks, bool fail) {
+    Vector<int> buffer(4);
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        co_await ready;
+        for (size_t i = 0; i < buffer.Size(); ++i) {
+            buffer[i] = chunk * 4 + static_cast<int>(i);
+        }
+        co_yield ConstVectorView<int>(buffer);
+    }
+    if (fail) {
+        co_await ready;
+        throw std::runtime_error("read failed");
+    }
+}
+#endif
+
+void Test20() {
+#if __cplusplus >= 202002L
+    {
+        Vector<int> v;
+        v.PushBack(-1);
+        assert(AppendFrom(v, Squares(100)) == 100);
+        assert(v.Size() == 101 && v[0] == -1 && v[100] == 99 * 99);
+        // Подсказка зарезервировала место сразу
+        assert(v.Capacity() == 101);
+    }
+    {
+        std::string text;
+        for (int i = 0; i < 1000; ++i) {
+            text.append(i == 0 ? "" : " ").append(std::to_string(i));
+        }
+        Vector<int> v;
+        assert(AppendChunks(v, ParseChunks(text, 64)) == 1000);
+        assert(v.Size() == 1000 && v.Capacity() == 1000);
+        for (int i = 0; i < 1000; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        // Нетривиальные элементы дописываются с удвоением ёмкости
+        Vector<std::string> v;
+        assert(AppendChunks(v, StringChunks(1000)) == 2000);
+        assert(v.Size() == 2000 && v[1998] == "999" && v[1999] == "-999");
+        assert(v.Capacity() == 2048);
+    }
+    {
+        ManualEvent ready;
+        Vector<int> v;
+        AppendTask task = AppendChunksAsync(v, ReadChunksAsync(ready, 3, false));
+        for (size_t events = 0; !task.Done(); ++events) {
+            assert(v.Size() == 4 * events);
+            ready.Fire();
+        }
+        assert(task.Result() == 12);
+        for (int i = 0; i < 12; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        ManualEvent ready;
+        Vector<int> v;
+        AppendTask task = AppendChunksAsync(v, ReadChunksAsync(ready, 1, true));
+        ready.Fire();
+        ready.Fire();
+        assert(task.Done() && v.Size() == 4);
+        try {
+            task.Result();
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+#endif
+}
+
+void Test21() {
+    {
+        // Очередь FIFO с заворотом через конец буфера
+        RingVector<int> ring;
+        for (int i = 0; i < 8; ++i) {
+            ring.PushBack(i);
+        }
+        assert(ring.Capacity() == 8);
+        for (int i = 0; i < 5; ++i) {
+            assert(ring.Front() == i);
+            ring.PopFront();
+        }
+        for (int i = 8; i < 13; ++i) {
+            ring.PushBack(i);
+        }
+        assert(ring.Size() == 8 && ring.Capacity() == 8);
+        const auto [first, second] = ring.Spans();
+        assert(first.Size() == 3 && first[0] == 5 && second.Size() == 5 && second[4] == 12);
+        // Рост разворачивает содержимое в один участок
+        ring.PushBack(13);
+        assert(ring.Capacity() == 16 && ring.Spans().second.Empty());
+        for (int i = 0; i < 9; ++i) {
+            assert(ring[i] == 5 + i);
+        }
+    }
+    {
+        RingVector<std::string> ring;
+        for (int i = 0; i < 10; ++i) {
+            ring.PushFront(std::to_string(i));
+            ring.PushBack(std::to_string(-i));
+        }
+        assert(ring.Size() == 20 && ring.Front() == "9" && ring.Back() == "-9");
+        ring.PopBack();
+        ring.PopFront();
+        assert(ring.Front() == "8" && ring.Back() == "-8");
+        // Аргумент, ссылающийся на элемент самого буфера, переживает рост
+        while (ring.Size() != ring.Capacity()) {
+            ring.PushBack(std::string("x"));
+        }
+        ring.PushFront(ring.Back());
+        assert(ring.Front() == "x");
+
+        RingVector<std::string> copy(ring);
+        assert(std::equal(copy.begin(), copy.end(), ring.begin(), ring.end()));
+        RingVector<std::string> moved(std::move(copy));
+        assert(copy.Empty() && moved.Size() == ring.Size());
+        moved = ring;
+        moved.Reserve(1000);
+        assert(moved.Capacity() == 1000 && std::equal(moved.begin(), moved.end(), ring.begin(), ring.end()));
+    }
+    {
+        // Элементы с бросающим перемещением при росте копируются, как в Vector::Reserve
+        struct ThrowingMove {
+            ThrowingMove(int v)
+                : value(v) {
+            }
+            ThrowingMove(const ThrowingMove& other)
+                : value(other.value) {
+            }
+            ThrowingMove(ThrowingMove&& other) noexcept(false)
+                : value(other.value) {
+                other.value = -1;
+            }
+            ~ThrowingMove() {
+            }
+            int value;
+        };
+        RingVector<ThrowingMove> ring;
+        for (int i = 0; i < 6; ++i) {
+            ring.PushFront(ThrowingMove(i));
+        }
+        for (int i = 0; i < 6; ++i) {
+            assert(ring[i].value == 5 - i);
+        }
+    }
+}
+
+void Test22() {
+    constexpr int COUNT = 100'000;
+    {
+        SpscQueue<int> queue(100);
+        assert(queue.Capacity() == 128);
+        std::thread producer([&queue] {
+            int batch[16];
+            for (int next = 0; next < COUNT;) {
+                const int n = std::min(16, COUNT - next);
+                for (int i = 0; i < n; ++i) {
+                    batch[i] = next + i;
+                }
+                const size_t pushed = queue.TryPushN(batch, n);
+                next += static_cast<int>(pushed);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        int expected = 0;
+        int batch[32];
+        while (expected < COUNT) {
+            const size_t popped = queue.TryPopN(batch, 32);
+            for (size_t i = 0; i < popped; ++i) {
+                assert(batch[i] == expected++);
+            }
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        assert(queue.SizeApprox() == 0);
+    }
+    {
+        MpmcQueue<uint64_t> queue(64);
+        constexpr int THREADS = 2;
+        std::atomic<uint64_t> sum{0};
+        std::atomic<int> popped{0};
+        Vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.EmplaceBack([&queue, t] {
+                for (int i = t; i < COUNT; i += THREADS) {
+                    const uint64_t value = static_cast<uint64_t>(i);
+                    while (!queue.TryPush(value)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.EmplaceBack([&queue, &sum, &popped] {
+                uint64_t batch[8];
+                while (popped.load() < COUNT) {
+                    const size_t n = queue.TryPopN(batch, 8);
+                    for (size_t i = 0; i < n; ++i) {
+                        sum += batch[i];
+                    }
+                    popped += static_cast<int>(n);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        assert(popped == COUNT);
+        assert(sum == uint64_t{COUNT} * (COUNT - 1) / 2);
+    }
+    {
+        // Очередь полна и пуста на границах; оставшиеся элементы разрушаются вместе с ней
+        MpmcQueue<std::string> queue(4);
+        std::string values[] = {"a", "b", "c", "d", "e"};
+        assert(queue.TryPushN(std::make_move_iterator(values), 5) == 4);
+        assert(!queue.TryPush("f"));
+        std::string out;
+        assert(queue.TryPop(out) && out == "a");
+        assert(queue.TryPush(std::string(100, 'x')));
+        std::string batch[8];
+        assert(queue.TryPopN(batch, 2) == 2 && batch[0] == "b" && batch[1] == "c");
+        assert(queue.SizeApprox() == 2);
+
+        SpscQueue<std::string> spsc(2);
+        assert(spsc.TryPush(std::string(100, 'y')) && spsc.TryPush("z") && !spsc.TryPush("w"));
+    }
+}
+
+void Test23() {
+    {
+        // Набор текста с правками вокруг курсора
+        GapVector<char> text;
+        text.Reserve(32);
+        for (char c : std::string("hello world")) {
+            text.PushBack(c);
+        }
+        text.Insert(5, ',');
+        assert(text.GapPosition() == 6);
+        for (char c : std::string(" dear")) {
+            text.Insert(text.GapPosition(), c);
+        }
+        text.Erase(text.GapPosition());
+        assert(std::string(text.begin(), text.end()) == "hello, dearworld");
+        assert(text.Capacity() == 32);
+        const auto [before, after] = text.Spans();
+        assert(std::string(before.begin(), before.end()) == "hello, dear");
+        assert(std::string(after.begin(), after.end()) == "world");
+        // Перенос разрыва назад и вперёд
+        text.Insert(0, '>');
+        text.Erase(text.Size() - 1);
+        assert(std::string(text.begin(), text.end()) == ">hello, dearworl");
+    }
+    {
+        GapVector<std::string> lines;
+        for (int i = 0; i < 10; ++i) {
+            lines.PushBack(std::to_string(i));
+        }
+        for (int i = 0; i < 10; ++i) {
+            lines.Insert(5, std::string("x").append(std::to_string(i)));
+        }
+        lines.Erase(0);
+        lines.Insert(lines.Size(), lines[0]);
+        assert(lines.Size() == 20 && lines[4] == "x9" && lines[13] == "x0" && lines[19] == "1");
+
+        GapVector<std::string> copy(lines);
+        assert(std::equal(copy.begin(), copy.end(), lines.begin(), lines.end()));
+        copy.Reserve(100);
+        copy.Insert(3, "y");
+        assert(copy.Capacity() == 100 && copy[3] == "y" && copy[4] == "4" && copy[5] == "x9");
+        lines = std::move(copy);
+        assert(lines.Size() == 21 && copy.Empty());
+        while (!lines.Empty()) {
+            lines.PopBack();
+        }
+    }
+}
+
+void Test24() {
+    using Handle = SlotMap<std::string>::Handle;
+    SlotMap<std::string> entities;
+    assert(!entities.Contains(Handle{}));
+    Vector<Handle> handles;
+    for (int i = 0; i < 8; ++i) {
+        handles.PushBack(entities.Insert(std::string("e").append(std::to_string(i))));
+    }
+    assert(entities.Size() == 8 && entities[handles[3]] == "e3");
+
+    // Удаление переносит последнее значение на освободившееся место
+    assert(entities.Erase(handles[2]));
+    assert(!entities.Erase(handles[2]));
+    assert(entities.Size() == 7 && entities.Values()[2] == "e7");
+    assert(entities.HandleAt(2) == handles[7] && entities[handles[7]] == "e7");
+    assert(entities.Find(handles[2]) == nullptr);
+
+    // Слот переиспользуется, но старый ключ к нему не подходит
+    const Handle reused = entities.Emplace(3, 'z');
+    assert(reused.index == handles[2].index && reused != handles[2]);
+    assert(!entities.Contains(handles[2]) && *entities.Find(reused) == "zzz");
+
+    size_t total = 0;
+    for (const std::string& value : entities) {
+        total += value.size();
+    }
+    assert(total == 7 * 2 + 3);
+
+    SlotMap<std::string> copy(entities);
+    entities.Clear();
+    assert(entities.Empty() && !entities.Contains(handles[0]) && !entities.Contains(reused));
+    assert(copy.Size() == 8 && copy[handles[0]] == "e0" && copy[reused] == "zzz");
+    for (const Handle handle : handles) {
+        copy.Erase(handle);
+    }
+    assert(copy.Size() == 1 && copy.HandleAt(0) == reused);
+
+    // Ключ с поколением свободного слота не находит значения
+    SlotMap<std::string> other;
+    const Handle first = other.Insert("a");
+    other.Insert("b");
+    other.Erase(first);
+    const Handle pending{first.index, first.generation + 1};
+    assert(!other.Contains(pending) && other.Find(pending) == nullptr && !other.Erase(pending));
+    try {
+        other.Emplace(std::string::npos, 'x');
+        assert(false && "Exception is expected");
+    } catch (const std::length_error&) {
+    }
+    assert(other.Size() == 1 && !other.Contains(pending));
+    assert(!other.Contains(Handle{static_cast<uint32_t>(2), 1}));
+}
+
+void Test25() {
+    {
+        Vector<std::string> timers;
+        for (int i = 0; i < 6; ++i) {
+            timers.PushBack(std::string("t").append(std::to_string(i)));
+        }
+        auto it = timers.EraseUnordered(timers.begin() + 1);
+        assert(timers.Size() == 5 && *it == "t5" && timers[4] == "t4");
+        it = timers.EraseUnordered(timers.end() - 1);
+        assert(it == timers.end() && timers.Size() == 4);
+    }
+    {
+        Vector<int> connections;
+        for (int i = 0; i < 20; ++i) {
+            connections.PushBack(i);
+        }
+        // Удаляемые элементы стоят и в начале, и в конце, и подряд
+        const size_t erased = connections.EraseUnorderedIf([](int value) {
+            return value % 3 == 0 || value >= 17;
+        });
+        assert(erased == 9 && connections.Size() == 11);
+        int sum = 0;
+        for (int value : connections) {
+            assert(value % 3 != 0 && value < 17);
+            sum += value;
+        }
+        assert(sum == 1 + 2 + 4 + 5 + 7 + 8 + 10 + 11 + 13 + 14 + 16);
+        assert(connections.EraseUnorderedIf([](int) { return true; }) == 11 && connections.Size() == 0);
+    }
+}
+
+void Test26() {
+    {
+        // Списки смежности графа
+        Vector<Vector<int>> nested(4);
+        nested[0].PushBack(1);
+        nested[0].PushBack(2);
+        nested[2].PushBack(0);
+        nested[3].PushBack(0);
+        nested[3].PushBack(1);
+        nested[3].PushBack(2);
+        JaggedVector<int> graph(nested);
+        assert(graph.RowCount() == 4 && graph.Size() == 6);
+        assert(graph.RowSize(0) == 2 && graph[1].Empty() && graph[2][0] == 0 && graph.Row(3)[2] == 2);
+        assert(graph.Values().Data() + 3 == graph[3].Data());
+
+        graph.AppendRow();
+        graph.PushBack(3);
+        graph.EmplaceBack(4);
+        graph[0][1] = 7;
+        assert(graph.RowCount() == 5 && graph.RowSize(4) == 2 && graph[4][1] == 4 && graph[0][1] == 7);
+        graph.PopRow();
+        graph.PopRow();
+        assert(graph.RowCount() == 3 && graph.Size() == 3);
+        graph.Clear();
+        assert(graph.Empty() && graph.Size() == 0);
+    }
+    {
+        Vector<Vector<std::string>> nested(3);
+        nested[0].PushBack("a");
+        nested[2].PushBack("b");
+        nested[2].PushBack("c");
+        JaggedVector<std::string> words(std::move(nested));
+        assert(words.RowCount() == 3 && words[2][1] == "c");
+        const std::string extra[] = {"x", "y"};
+        words.AppendRow(std::begin(extra), std::end(extra));
+        JaggedVector<std::string> copy(words);
+        copy.PushBack("z");
+        assert(copy.RowSize(3) == 3 && words.RowSize(3) == 2 && copy[3][0] == "x");
+
+        // Повтор строки из этого же массива переживает перенос буфера
+        for (int i = 0; i < 4; ++i) {
+            words.AppendRow(words[words.RowCount() - 1]);
+        }
+        words.AppendRow(words.Values().begin(), words.Values().begin() + 2);
+        assert(words.RowCount() == 9 && words[7][1] == "y" && words[8][0] == "a" && words[8][1] == "b");
+    }
+    {
+        JaggedVector<int> rows;
+        rows.AppendRow();
+        for (int i = 0; i < 5; ++i) {
+            rows.PushBack(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            rows.AppendRow(rows[rows.RowCount() - 1]);
+        }
+        assert(rows.RowCount() == 7 && rows.Size() == 35 && rows[6][4] == 4);
+    }
+    {
+        // Построчное наполнение перевыделяет концы строк лишь O(log n) раз
+        JaggedVector<int> rows;
+        const int row[] = {1, 2, 3};
+        size_t reallocations = 0;
+        const size_t* row_ends = nullptr;
+        for (int i = 0; i < 1000; ++i) {
+            rows.AppendRow(ConstVectorView<int>(row, 3));
+            if (rows.RowEnds().Data() != row_ends) {
+                row_ends = rows.RowEnds().Data();
+                ++reallocations;
+            }
+        }
+        assert(rows.RowCount() == 1000 && reallocations <= 11);
+    }
+}
+
+void Test27() {
+    uint64_t state = 42;
+    const auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 16;
+    };
+    {
+        for (size_t n : {size_t{10}, size_t{5000}}) {
+            Vector<uint32_t> u32;
+            Vector<int64_t> i64;
+            Vector<float> f32;
+            for (size_t i = 0; i < n; ++i) {
+                u32.PushBack(static_cast<uint32_t>(next()));
+                i64.PushBack(static_cast<int64_t>(next()) - (int64_t{1} << 40));
+                f32.PushBack((static_cast<float>(next() % 20001) - 10000.0f) / 7.0f);
+            }
+            std::vector<uint32_t> u32_expected(u32.begin(), u32.end());
+            std::vector<int64_t> i64_expected(i64.begin(), i64.end());
+            std::vector<float> f32_expected(f32.begin(), f32.end());
+            std::sort(u32_expected.begin(), u32_expected.end());
+            std::sort(i64_expected.begin(), i64_expected.end());
+            std::sort(f32_expected.begin(), f32_expected.end());
+            Sort(u32);
+            Sort(i64);
+            Sort(f32);
+            assert(std::equal(u32.begin(), u32.end(), u32_expected.begin(), u32_expected.end()));
+            assert(std::equal(i64.begin(), i64.end(), i64_expected.begin(), i64_expected.end()));
+            assert(std::equal(f32.begin(), f32.end(), f32_expected.begin(), f32_expected.end()));
+        }
+    }
+    {
+        // Все ключи в одном старшем байте: лишние проходы пропускаются
+        Vector<double> values;
+        for (int i = 0; i < 1000; ++i) {
+            values.PushBack(i % 2 == 0 ? -0.5 * i : 0.25 * i);
+        }
+        values.PushBack(-std::numeric_limits<double>::infinity());
+        Sort(values);
+        assert(std::is_sorted(values.begin(), values.end()) && values[0] < -1e300);
+        Sort(values, std::greater<>());
+        assert(std::is_sorted(values.begin(), values.end(), std::greater<>()));
+    }
+    {
+        struct Event {
+            int16_t priority;
+            uint32_t id;
+        };
+        Vector<Event> events;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            events.PushBack(Event{static_cast<int16_t>(static_cast<int>(next() % 21) - 10), i});
+        }
+        SortByKey(events, [](const Event& e) {
+            return e.priority;
+        });
+        // Сортировка по ключу устойчива
+        for (size_t i = 1; i < events.Size(); ++i) {
+            const Event& a = events[i - 1];
+            const Event& b = events[i];
+            assert(a.priority < b.priority || (a.priority == b.priority && a.id < b.id));
+        }
+
+        Vector<std::string> words;
+        for (const char* word : {"ccc", "a", "bb", "d", "ee"}) {
+            words.PushBack(word);
+        }
+        SortByKey(words, [](const std::string& word) {
+            return word.size();
+        });
+        assert(words[0] == "a" && words[1] == "d" && words[2] == "bb" && words[3] == "ee" && words[4] == "ccc");
+    }
+}
+
+void Test28() {
+    uint64_t state = 7;
+    const auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 16;
+    };
+    {
+        // 5 частей: в каждом раунде остаётся серия без пары
+        for (size_t threads : {size_t{1}, size_t{2}, size_t{5}, size_t{8}}) {
+            Vector<int> values;
+            for (int i = 0; i < 50000; ++i) {
+                values.PushBack(static_cast<int>(next() % 100000) - 50000);
+            }
+            std::vector<int> expected(values.begin(), values.end());
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+            ParallelSort(values, std::greater<>(), threads);
+            assert(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+        }
+    }
+    {
+        Vector<std::pair<int, std::string>> records;
+        for (int i = 0; i < 30000; ++i) {
+            records.EmplaceBack(static_cast<int>(next() % 100), std::to_string(i));
+        }
+        std::vector<std::pair<int, std::string>> expected(records.begin(), records.end());
+        const auto by_key = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+        std::stable_sort(expected.begin(), expected.end(), by_key);
+        ParallelStableSort(records, by_key, 3);
+        assert(std::equal(records.begin(), records.end(), expected.begin(), expected.end()));
+        ParallelSort(records);
+        assert(std::is_sorted(records.begin(), records.end()));
+    }
+}
+
+void Test29() {
+    uint64_t state = 3;
+    const auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<int>((state >> 33) % 1000);
+    };
+    {
+        Vector<int> values;
+        for (int i = 0; i < 500; ++i) {
+            values.PushBack(next());
+        }
+        std::vector<int> expected(values.begin(), values.end());
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        const int* storage = values.begin();
+
+        // Построение из готового вектора переиспользует его буфер
+        Heap<int> heap(std::move(values));
+        assert(heap.Size() == 500 && heap.Values().Data() == storage && heap.Top() == expected[0]);
+        Vector<int> popped;
+        assert(heap.PopN(100, popped) == 100);
+        assert(std::equal(popped.begin(), popped.end(), expected.begin(), expected.begin() + 100));
+
+        const int batch[] = {2000, -1, 1500};
+        heap.PushBatch(std::begin(batch), std::end(batch));
+        heap.Push(1999);
+        assert(heap.Pop() == 2000 && heap.Pop() == 1999 && heap.Pop() == 1500);
+        assert(heap.PopN(1000, popped) == 401 && heap.Empty() && popped[popped.Size() - 1] == -1);
+        Vector<int> storage_back = heap.Release();
+        assert(storage_back.begin() == storage && storage_back.Capacity() >= 500);
+    }
+    {
+        // 4-арная куча с обратным порядком: на вершине наименьший
+        Heap<std::string, std::greater<>, 4> heap;
+        heap.Reserve(64);
+        Vector<std::string> words;
+        for (int i = 0; i < 40; ++i) {
+            words.PushBack(std::to_string(next() + 1000));
+        }
+        heap.PushBatch(words.begin(), words.end());
+        heap.PushBatch(words.begin(), words.begin() + 3);
+        heap.Emplace(3, '0');
+        assert(heap.Capacity() == 64 && heap.Top() == "000");
+        std::vector<std::string> expected(words.begin(), words.end());
+        expected.insert(expected.end(), words.begin(), words.begin() + 3);
+        expected.push_back("000");
+        std::sort(expected.begin(), expected.end());
+        for (const std::string& word : expected) {
+            assert(heap.Pop() == word);
+        }
+        assert(heap.Empty());
+    }
+    {
+        // Исключение посреди пачки откатывает уже добавленные элементы
+        struct Throwing {
+            int value;
+            Throwing(int v)
+                : value(v) {
+            }
+            Throwing(const Throwing& other)
+                : value(other.value) {
+                if (value < 0) {
+                    throw std::runtime_error("copy");
+                }
+            }
+            Throwing& operator=(const Throwing&) = default;
+            bool operator<(const Throwing& rhs) const {
+                return value < rhs.value;
+            }
+        };
+        Heap<Throwing> heap;
+        heap.Reserve(16);
+        for (int value : {3, 1, 2}) {
+            heap.Emplace(value);
+        }
+        const Throwing batch[] = {10, 20, -1, 30};
+        try {
+            heap.PushBatch(std::begin(batch), std::end(batch));
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(heap.Size() == 3 && heap.Top().value == 3);
+        assert(heap.Pop().value == 3 && heap.Pop().value == 2 && heap.Pop().value == 1);
+    }
+    {
+        // Повторяющиеся малые пачки перевыделяют память лишь O(log n) раз
+        Heap<int> heap;
+        Vector<int> out;
+        size_t heap_reallocations = 0;
+        size_t out_reallocations = 0;
+        const int* heap_storage = nullptr;
+        const int* out_storage = nullptr;
+        for (int i = 0; i < 1000; ++i) {
+            const int batch[] = {i, -i};
+            heap.PushBatch(std::begin(batch), std::end(batch));
+            if (heap.Values().Data() != heap_storage) {
+                heap_storage = heap.Values().Data();
+                ++heap_reallocations;
+            }
+        }
+        for (int i = 0; i < 1000; ++i) {
+            heap.PopN(2, out);
+            if (out.begin() != out_storage) {
+                out_storage = out.begin();
+                ++out_reallocations;
+            }
+        }
+        assert(heap.Empty() && out.Size() == 2000 && out[0] == 999);
+        assert(heap_reallocations <= 12 && out_reallocations <= 12);
+    }
+}
+
+void Test30() {
+    uint64_t state = 11;
+    const auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(state >> 33);
+    };
+    // Отсортированный вектор без повторов из n значений в [0, range)
+    const auto make_set = [&next](size_t n, uint32_t range) {
+        Vector<uint32_t> values;
+        for (size_t i = 0; i < n; ++i) {
+            values.PushBack(next() % range);
+        }
+        Sort(values);
+        Unique(values);
+        return values;
+    };
+    const auto check = [](const Vector<uint32_t>& a, const Vector<uint32_t>& b) {
+        std::vector<uint32_t> expected;
+        Vector<uint32_t> out;
+        out.PushBack(12345);
+
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(SetIntersection(a, b, out) == expected.size());
+        assert(out[0] == 12345 && std::equal(out.begin() + 1, out.end(), expected.begin(), expected.end()));
+
+        expected.clear();
+        out.Resize(1);
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(SetUnion(a, b, out) == expected.size());
+        assert(std::equal(out.begin() + 1, out.end(), expected.begin(), expected.end()));
+
+        expected.clear();
+        out.Resize(1);
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(SetDifference(a, b, out) == expected.size());
+        assert(std::equal(out.begin() + 1, out.end(), expected.begin(), expected.end()));
+    };
+    {
+        Vector<uint32_t> values;
+        for (uint32_t value : {1u, 1u, 2u, 3u, 3u, 3u, 7u}) {
+            values.PushBack(value);
+        }
+        assert(Unique(values) == 3 && values.Size() == 4 && values[3] == 7);
+        assert(Unique(values) == 0);
+    }
+    // Соизмеримые размеры (векторное пересечение) и сильный перекос (galloping) в обе стороны
+    const Vector<uint32_t> large = make_set(20000, 40000);
+    const Vector<uint32_t> medium = make_set(15000, 40000);
+    const Vector<uint32_t> small = make_set(50, 40000);
+    const Vector<uint32_t> empty;
+    check(large, medium);
+    check(medium, large);
+    check(large, small);
+    check(small, large);
+    check(large, empty);
+    check(empty, small);
+    check(large, large);
+    {
+        // Блок a с повторами сравнивается с несколькими блоками повторов b:
+        // результат не выходит за min(na, nb)
+        Vector<uint32_t> a;
+        Vector<uint32_t> b;
+        for (uint32_t i = 0; i < 16; ++i) {
+            a.PushBack(i < 7 ? 5 : 1000 + i);
+        }
+        for (uint32_t i = 0; i < 40; ++i) {
+            b.PushBack(5);
+        }
+        Vector<uint32_t> out;
+        const size_t count = SetIntersection(a, b, out);
+        assert(count <= a.Size() && out.Size() == count);
+        for (uint32_t value : out) {
+            assert(value == 5);
+        }
+        std::vector<uint32_t> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(count >= expected.size());
+    }
+    {
+        Vector<std::string> a;
+        Vector<std::string> b;
+        for (const char* word : {"apple", "kiwi", "lemon", "pear"}) {
+            a.PushBack(word);
+        }
+        for (const char* word : {"fig", "kiwi", "pear", "plum"}) {
+            b.PushBack(word);
+        }
+        Vector<std::string> out;
+        out.Reserve(16);
+        assert(SetIntersection(a, b, out) == 2 && out[0] == "kiwi" && out[1] == "pear");
+        assert(SetDifference(a, b, out) == 2 && out[2] == "apple" && out[3] == "lemon");
+        assert(SetUnion(a, b, out) == 6 && out[4] == "apple" && out[9] == "plum");
+        assert(out.Capacity() == 16);
+    }
+    {
+        // Совпавшие элементы берутся из a при любом соотношении длин
+        using Tagged = std::pair<int, char>;
+        const auto by_key = [](const Tagged& lhs, const Tagged& rhs) {
+            return lhs.first < rhs.first;
+        };
+        for (const auto& [na, nb] : {std::pair<int, int>{200, 2}, std::pair<int, int>{2, 200}, std::pair<int, int>{50, 50}}) {
+            Vector<Tagged> a;
+            Vector<Tagged> b;
+            for (int i = 0; i < na; ++i) {
+                a.PushBack(Tagged{i * 3, 'a'});
+            }
+            for (int i = 0; i < nb; ++i) {
+                b.PushBack(Tagged{i * 3, 'b'});
+            }
+            Vector<Tagged> out;
+            assert(SetIntersection(a, b, out, by_key) == static_cast<size_t>(std::min(na, nb)));
+            assert(std::all_of(out.begin(), out.end(), [](const Tagged& value) {
+                return value.second == 'a';
+            }));
         }
-        Dump();
-    } catch (...) {
     }
 }
 
@@ -647,7 +2265,30 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
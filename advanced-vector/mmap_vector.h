@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Заголовок, с которого начинается отображаемый файл. Элементы лежат сразу
+ * за ним по фиксированному смещению, поэтому адресация не зависит от того,
+ * по какому адресу файл отображён в конкретном процессе.
+ */
+struct alignas(64) MappedVectorHeader {
+    static constexpr uint32_t MAGIC = 0x564D5641;  // "AVMV"
+
+    uint32_t magic = MAGIC;
+    uint32_t element_size = 0;
+    // Атомарен, чтобы читатели из других процессов видели только уже записанные элементы:
+    // писатель публикует новый размер с release, читатель загружает его с acquire
+    std::atomic<uint64_t> size{0};
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared size counter must be lock-free");
+};
+
+// Бросает std::system_error с текущим errno
+[[noreturn]] inline void ThrowSystemError(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/*
+ * Вектор тривиально копируемых элементов, хранящихся в файле, отображённом
+ * в память через mmap. Reserve расширяет файл и переотображает его,
+ * элементы пишутся прямо в отображение, а повторное открытие файла
+ * мгновенно восстанавливает вектор без фазы загрузки.
+ *
+ * Как и Vector, вектор после перемещения пуст; он не связан с файлом,
+ * поэтому операции, которым нужно место, бросают std::logic_error.
+ */
+template <typename T>
+class MmapVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MmapVector requires a trivially copyable type");
+    static_assert(alignof(T) <= alignof(MappedVectorHeader), "MmapVector element alignment is too large");
+
+public:
+    static constexpr size_t DATA_OFFSET = sizeof(MappedVectorHeader);
+
+    /**
+     * Конструкторы
+     */
+
+    // Открывает файл path, создавая его при отсутствии
+    explicit MmapVector(const std::string& path)
+        : MmapVector(OpenFile(path)) {
+    }
+
+    // Принимает во владение открытый на чтение и запись дескриптор
+    explicit MmapVector(int fd)
+        : fd_(fd) {
+        try {
+            Map();
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    MmapVector(const MmapVector&) = delete;
+    MmapVector& operator=(const MmapVector&) = delete;
+
+    MmapVector(MmapVector&& other) noexcept {
+        Swap(other);
+    }
+
+    MmapVector& operator=(MmapVector&& rhs) noexcept {
+        if (this != &rhs) {
+            MmapVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    ~MmapVector() {
+        if (header_ != nullptr) {
+            ::munmap(header_, mapped_bytes_);
+        }
+        if (fd_ != -1) {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * Итераторы
+     */
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + Size();
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+
+    /**
+     * Операторы
+     */
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<MmapVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    /**
+     * Методы
+     */
+
+    void Swap(MmapVector& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(header_, other.header_);
+        std::swap(mapped_bytes_, other.mapped_bytes_);
+    }
+
+    size_t Size() const noexcept {
+        return header_ == nullptr ? 0 : header_->size.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const noexcept {
+        return header_ == nullptr ? 0 : (mapped_bytes_ - DATA_OFFSET) / sizeof(T);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        if (header_ == nullptr) {
+            throw std::logic_error("MmapVector is not attached to a file");
+        }
+        const size_t new_bytes = DATA_OFFSET + new_capacity * sizeof(T);
+        if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        Remap(new_bytes);
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        const size_t size = Size();
+        if (size == Capacity()) {
+            // Аргументы могут ссылаться на элементы, которые переедут при переотображении
+            T value(std::forward<Args>(args)...);
+            Reserve(std::max(size * 2, MIN_CAPACITY));
+            T* result = new (Data() + size) T(value);
+            SetSize(size + 1);
+            return *result;
+        }
+        T* result = new (Data() + size) T(std::forward<Args>(args)...);
+        SetSize(size + 1);
+        return *result;
+    }
+
+    template <typename B>
+    void PushBack(B&& value) {
+        EmplaceBack(std::forward<B>(value));
+    }
+
+    void PopBack() noexcept {
+        const size_t size = Size();
+        if (size > 0) {
+            SetSize(size - 1);
+        }
+    }
+
+    void Resize(size_t new_size) {
+        const size_t size = Size();
+        if (new_size == size) {
+            return;
+        }
+        if (new_size > size) {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(Data() + size, new_size - size);
+        }
+        SetSize(new_size);
+    }
+
+    // Сбрасывает изменения на диск
+    void Sync() {
+        if (header_ != nullptr && ::msync(header_, mapped_bytes_, MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+private:
+    // Первое расширение файла сразу занимает страницу
+    static constexpr size_t MIN_CAPACITY = std::max<size_t>(1, 4096 / sizeof(T));
+
+    int fd_ = -1;
+    MappedVectorHeader* header_ = nullptr;
+    size_t mapped_bytes_ = 0;
+
+    static int OpenFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd == -1) {
+            ThrowSystemError("open");
+        }
+        return fd;
+    }
+
+    void SetSize(size_t size) noexcept {
+        header_->size.store(size, std::memory_order_release);
+    }
+
+    T* Data() noexcept {
+        if (header_ == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(header_) + DATA_OFFSET);
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<MmapVector&>(*this).Data();
+    }
+
+    // Отображает файл целиком, инициализируя заголовок пустого файла
+    void Map() {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            ThrowSystemError("fstat");
+        }
+        size_t bytes = static_cast<size_t>(st.st_size);
+        const bool is_new = bytes == 0;
+        if (is_new) {
+            bytes = DATA_OFFSET;
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+                ThrowSystemError("ftruncate");
+            }
+        } else if (bytes < DATA_OFFSET) {
+            throw std::runtime_error("Mapped vector file is truncated");
+        }
+
+        void* addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        header_ = static_cast<MappedVectorHeader*>(addr);
+        mapped_bytes_ = bytes;
+
+        if (is_new) {
+            new (header_) MappedVectorHeader{};
+            header_->element_size = sizeof(T);
+        } else if (header_->magic != MappedVectorHeader::MAGIC || header_->element_size != sizeof(T)
+                   || Size() > Capacity()) {
+            ::munmap(header_, mapped_bytes_);
+            header_ = nullptr;
+            throw std::runtime_error("Not a mapped vector file of this element type");
+        }
+    }
+
+    void Remap(size_t new_bytes) {
+#ifdef __linux__
+        void* addr = ::mremap(header_, mapped_bytes_, new_bytes, MREMAP_MAYMOVE);
+        if (addr == MAP_FAILED) {
+            ThrowSystemError("mremap");
+        }
+#else
+        void* addr = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        ::munmap(header_, mapped_bytes_);
+#endif
+        header_ = static_cast<MappedVectorHeader*>(addr);
+        mapped_bytes_ = new_bytes;
+    }
+};
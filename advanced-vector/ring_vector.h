@@ -0,0 +1,264 @@
+#pragma once
+#include "index_iterator.h"
+#include "vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <utility>
+
+/*
+ * Кольцевой буфер с ростом: очередь с добавлением и удалением за O(1) с обоих
+ * концов. Элементы занимают в RawMemory не более двух непрерывных участков
+ * (Spans). При росте содержимое переносится в новый буфер развёрнутым в один
+ * участок с тем же выбором между перемещением и копированием, что и в Vector::Reserve.
+ */
+template <typename T>
+class RingVector {
+public:
+    /**
+     * Конструкторы
+     */
+    RingVector() = default;
+
+    RingVector(const RingVector& other)
+        : data_(other.size_) {
+        const auto [first, second] = other.Spans();
+        vector_detail::CopyN(first.Data(), first.Size(), data_.GetAddress());
+        try {
+            vector_detail::CopyN(second.Data(), second.Size(), data_.GetAddress() + first.Size());
+        } catch (...) {
+            std::destroy_n(data_.GetAddress(), first.Size());
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    RingVector(RingVector&& other) noexcept {
+        Swap(other);
+    }
+
+    ~RingVector() {
+        Clear();
+    }
+
+    /**
+     * Итераторы
+     */
+
+    using iterator = IndexIterator<RingVector, T>;
+    using const_iterator = IndexIterator<const RingVector, const T>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    /**
+     * Операторы
+     */
+
+    RingVector& operator=(const RingVector& rhs) {
+        if (this != &rhs) {
+            RingVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    RingVector& operator=(RingVector&& rhs) noexcept {
+        if (this != &rhs) {
+            RingVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<RingVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[Physical(index)];
+    }
+
+    /**
+     * Методы
+     */
+
+    void Swap(RingVector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    T& Front() noexcept {
+        return (*this)[0];
+    }
+
+    const T& Front() const noexcept {
+        return (*this)[0];
+    }
+
+    T& Back() noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    const T& Back() const noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    // Элементы по порядку: хвост буфера от головы и, если содержимое завернуло, его начало
+    std::pair<VectorView<T>, VectorView<T>> Spans() noexcept {
+        const size_t first = std::min(size_, data_.Capacity() - head_);
+        return {VectorView<T>(data_ + head_, first), VectorView<T>(data_.GetAddress(), size_ - first)};
+    }
+
+    std::pair<ConstVectorView<T>, ConstVectorView<T>> Spans() const noexcept {
+        const auto [first, second] = const_cast<RingVector&>(*this).Spans();
+        return {first, second};
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == data_.Capacity()) {
+            // Новый элемент создаётся до переноса: аргументы могут ссылаться на элементы буфера
+            return GrowWith(size_, std::forward<Args>(args)...);
+        }
+        T* result = vector_detail::ConstructAt(data_ + Physical(size_), std::forward<Args>(args)...);
+        ++size_;
+        return *result;
+    }
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (size_ == data_.Capacity()) {
+            // Новый элемент встаёт в последнюю ячейку нового буфера, остальные - в начало
+            T& result = GrowWith(NextCapacity() - 1, std::forward<Args>(args)...);
+            head_ = data_.Capacity() - 1;
+            return result;
+        }
+        const size_t head = head_ == 0 ? data_.Capacity() - 1 : head_ - 1;
+        T* result = vector_detail::ConstructAt(data_ + head, std::forward<Args>(args)...);
+        head_ = head;
+        ++size_;
+        return *result;
+    }
+
+    template <typename B>
+    void PushBack(B&& value) {
+        EmplaceBack(std::forward<B>(value));
+    }
+
+    template <typename B>
+    void PushFront(B&& value) {
+        EmplaceFront(std::forward<B>(value));
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        std::destroy_at(data_ + Physical(--size_));
+    }
+
+    void PopFront() noexcept {
+        assert(size_ > 0);
+        std::destroy_at(data_ + head_);
+        head_ = head_ + 1 == data_.Capacity() ? 0 : head_ + 1;
+        --size_;
+    }
+
+    void Clear() noexcept {
+        const auto [first, second] = Spans();
+        std::destroy_n(first.Data(), first.Size());
+        std::destroy_n(second.Data(), second.Size());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= data_.Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(new_capacity);
+        RelocateInto(new_data, 0);
+        Adopt(new_data);
+    }
+
+private:
+    RawMemory<T> data_;
+    // Позиция первого элемента в буфере
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    size_t Physical(size_t index) const noexcept {
+        const size_t position = head_ + index;
+        return position >= data_.Capacity() ? position - data_.Capacity() : position;
+    }
+
+    size_t NextCapacity() const noexcept {
+        return size_ == 0 ? 1 : size_ * 2;
+    }
+
+    // Переносит элементы в new_data одним участком, начиная с позиции offset
+    void RelocateInto(RawMemory<T>& new_data, size_t offset) {
+        const auto [first, second] = Spans();
+        vector_detail::RelocateN(first.Data(), first.Size(), new_data + offset);
+        try {
+            vector_detail::RelocateN(second.Data(), second.Size(), new_data + offset + first.Size());
+        } catch (...) {
+            std::destroy_n(new_data + offset, first.Size());
+            throw;
+        }
+    }
+
+    // Разрушает перенесённые оригиналы и переходит на new_data с развёрнутым содержимым
+    void Adopt(RawMemory<T>& new_data) noexcept {
+        const auto [first, second] = Spans();
+        std::destroy_n(first.Data(), first.Size());
+        std::destroy_n(second.Data(), second.Size());
+        data_.Swap(new_data);
+        head_ = 0;
+    }
+
+    // Удваивает полный буфер: новый элемент создаётся в ячейке position нового буфера,
+    // существующие переносятся в его начало
+    template <typename... Args>
+    T& GrowWith(size_t position, Args&&... args) {
+        RawMemory<T> new_data(NextCapacity());
+        T* result = vector_detail::ConstructAt(new_data + position, std::forward<Args>(args)...);
+        try {
+            RelocateInto(new_data, 0);
+        } catch (...) {
+            std::destroy_at(result);
+            throw;
+        }
+        Adopt(new_data);
+        ++size_;
+        return *result;
+    }
+};
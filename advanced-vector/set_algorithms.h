@@ -0,0 +1,269 @@
+#pragma once
+#include "flat_set.h"
+#include "vector.h"
+#include "vector_algorithms.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Удаление повторов и теоретико-множественные операции над отсортированными
+ * Vector. Результат дописывается в конец выходного вектора; место под
+ * наибольший возможный результат резервируется до записи, так что заранее
+ * зарезервированный вектор не перевыделяется. Выходной вектор не может быть
+ * одним из входов: резервирование перевыделило бы его буфер во время чтения.
+ *
+ * Если одна последовательность намного длиннее другой, пересечение и
+ * разность обходят короткую, а в длинной ищут экспоненциальным поиском
+ * (galloping) от текущей позиции: O(m log(n / m)) сравнений вместо O(n + m).
+ * Пересечение векторов uint32_t соизмеримой длины на x86 с AVX2 сравнивает
+ * блоки по 8 элементов каждого вектора со всеми циклическими сдвигами друг друга.
+ */
+
+namespace set_detail {
+
+// Во сколько раз одна последовательность должна быть длиннее другой для galloping
+inline constexpr size_t GALLOP_RATIO = 32;
+
+// Первая позиция в [first, first + n), не меньшая key. Граница ищется шагами
+// 1, 2, 4, ..., затем внутри найденного отрезка - двоичным поиском
+template <typename T, typename Compare>
+const T* Gallop(const T* first, size_t n, const T& key, const Compare& cmp) {
+    size_t lo = 0;
+    size_t bound = 1;
+    while (bound <= n && cmp(first[bound - 1], key)) {
+        lo = bound;
+        bound *= 2;
+    }
+    const size_t hi = std::min(bound - 1, n);
+    return FlatLowerBound(first + lo, hi - lo, key, cmp);
+}
+
+template <typename T, typename Compare>
+inline constexpr bool IS_NATURAL_ORDER = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+
+// Алгоритмы пересечения передают в emit найденные элементы первой последовательности a,
+// как std::set_intersection, независимо от того, какая из последовательностей короче
+
+template <typename T, typename Compare, typename Emit>
+void IntersectMerge(const T* a, size_t na, const T* b, size_t nb, const Compare& cmp, Emit&& emit) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < na && j < nb) {
+        if (cmp(a[i], b[j])) {
+            ++i;
+        } else if (cmp(b[j], a[i])) {
+            ++j;
+        } else {
+            emit(a[i]);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+// Пересечение короткой small и длинной large. EMIT_LARGE выбирает, из какой
+// последовательности передавать совпавший элемент: из той, что была a
+template <bool EMIT_LARGE, typename T, typename Compare, typename Emit>
+void IntersectGallop(const T* small, size_t ns, const T* large, size_t nl, const Compare& cmp, Emit&& emit) {
+    const T* const large_end = large + nl;
+    for (size_t i = 0; i < ns && large != large_end; ++i) {
+        large = Gallop(large, large_end - large, small[i], cmp);
+        if (large != large_end && !cmp(small[i], *large)) {
+            emit(EMIT_LARGE ? *large : small[i]);
+            ++large;
+        }
+    }
+}
+
+#ifdef ADVANCED_VECTOR_X86_DISPATCH
+
+#define ADVANCED_VECTOR_AVX2 __attribute__((target("avx2")))
+
+// Пишет в out не больше capacity элементов. Для входов без повторов каждый элемент a
+// совпадает не более чем с одним блоком b, и результат совпадает со слиянием. Элемент a,
+// равный повторам из разных блоков b, записывается несколько раз, поэтому без
+// ограничения результат мог бы выйти за min(na, nb)
+ADVANCED_VECTOR_AVX2 inline size_t IntersectAvx2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                                                 uint32_t* out, size_t capacity) noexcept {
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    // Блок записывает до 8 элементов; остаток места меньше блока дописывается скалярно
+    while (i + 8 <= na && j + 8 <= nb && count + 8 <= capacity) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i equal = _mm256_cmpeq_epi32(va, vb);
+        for (int shift = 1; shift < 8; ++shift) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+        }
+        for (unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal)); mask != 0; mask &= mask - 1) {
+            out[count++] = a[i + __builtin_ctz(mask)];
+        }
+        // Блок с меньшим максимумом больше ни с чем не совпадёт
+        const uint32_t a_max = a[i + 7];
+        const uint32_t b_max = b[j + 7];
+        i += a_max <= b_max ? 8 : 0;
+        j += b_max <= a_max ? 8 : 0;
+    }
+    IntersectMerge(a + i, na - i, b + j, nb - j, std::less<>(), [&](uint32_t value) {
+        if (count < capacity) {
+            out[count++] = value;
+        }
+    });
+    return count;
+}
+
+#undef ADVANCED_VECTOR_AVX2
+
+#endif  // ADVANCED_VECTOR_X86_DISPATCH
+
+template <typename T, typename Compare, typename Emit>
+void Intersect(const T* a, size_t na, const T* b, size_t nb, const Compare& cmp, Emit&& emit) {
+    if (na > nb * GALLOP_RATIO) {
+        IntersectGallop<true>(b, nb, a, na, cmp, emit);
+    } else if (nb > na * GALLOP_RATIO) {
+        IntersectGallop<false>(a, na, b, nb, cmp, emit);
+    } else {
+        IntersectMerge(a, na, b, nb, cmp, emit);
+    }
+}
+
+// Пересечение в неинициализированную память out на min(na, nb) элементов;
+// возвращает число записанных элементов
+template <typename T, typename Compare>
+size_t IntersectInto(const T* a, size_t na, const T* b, size_t nb, T* out, const Compare& cmp) {
+#ifdef ADVANCED_VECTOR_X86_DISPATCH
+    if constexpr (std::is_same_v<T, uint32_t> && IS_NATURAL_ORDER<T, Compare>) {
+        const bool skewed = na > nb * GALLOP_RATIO || nb > na * GALLOP_RATIO;
+        if (!skewed && vector_simd::HasAvx2()) {
+            return IntersectAvx2(a, na, b, nb, out, std::min(na, nb));
+        }
+    }
+#endif
+    T* const begin = out;
+    Intersect(a, na, b, nb, cmp, [&out](const T& value) {
+        *out++ = value;
+    });
+    return out - begin;
+}
+
+// Дописывает элементы a, не найденные в b
+template <typename T, typename Compare>
+void Difference(const T* a, size_t na, const T* b, size_t nb, Vector<T>& out, const Compare& cmp) {
+    const T* const a_end = a + na;
+    const T* const b_end = b + nb;
+    if (na > nb * GALLOP_RATIO) {
+        // Элементы a между соседними элементами b переносятся целыми отрезками
+        for (; b != b_end && a != a_end; ++b) {
+            const T* found = Gallop(a, a_end - a, *b, cmp);
+            for (; a != found; ++a) {
+                out.PushBack(*a);
+            }
+            if (a != a_end && !cmp(*b, *a)) {
+                ++a;
+            }
+        }
+    } else if (nb > na * GALLOP_RATIO) {
+        for (; a != a_end; ++a) {
+            b = Gallop(b, b_end - b, *a, cmp);
+            if (b == b_end || cmp(*a, *b)) {
+                out.PushBack(*a);
+            } else {
+                ++b;
+            }
+        }
+    } else {
+        while (a != a_end && b != b_end) {
+            if (cmp(*a, *b)) {
+                out.PushBack(*a++);
+            } else {
+                if (!cmp(*b, *a)) {
+                    ++a;
+                }
+                ++b;
+            }
+        }
+    }
+    for (; a != a_end; ++a) {
+        out.PushBack(*a);
+    }
+}
+
+}  // namespace set_detail
+
+// Удаляет из отсортированного вектора подряд идущие повторы, оставляя первый
+// из равных элементов. Возвращает число удалённых
+template <typename T, typename Equal = std::equal_to<>>
+size_t Unique(Vector<T>& v, Equal equal = Equal()) {
+    const size_t size = v.Size();
+    const size_t kept = std::unique(v.begin(), v.end(), equal) - v.begin();
+    while (v.Size() > kept) {
+        v.PopBack();
+    }
+    return size - kept;
+}
+
+// Объединение: элементы, равные в a и b, попадают в результат один раз (из a).
+// Возвращает число добавленных в out элементов
+template <typename T, typename Compare = std::less<>>
+size_t SetUnion(const Vector<T>& a, const Vector<T>& b, Vector<T>& out, Compare cmp = Compare()) {
+    assert(&out != &a && &out != &b);
+    const size_t old_size = out.Size();
+    out.Reserve(old_size + a.Size() + b.Size());
+    const T* i = a.begin();
+    const T* j = b.begin();
+    while (i != a.end() && j != b.end()) {
+        if (cmp(*j, *i)) {
+            out.PushBack(*j++);
+        } else {
+            if (!cmp(*i, *j)) {
+                ++j;
+            }
+            out.PushBack(*i++);
+        }
+    }
+    for (; i != a.end(); ++i) {
+        out.PushBack(*i);
+    }
+    for (; j != b.end(); ++j) {
+        out.PushBack(*j);
+    }
+    return out.Size() - old_size;
+}
+
+// Пересечение a и b без повторов внутри каждого входа.
+// Возвращает число добавленных в out элементов
+template <typename T, typename Compare = std::less<>>
+size_t SetIntersection(const Vector<T>& a, const Vector<T>& b, Vector<T>& out, Compare cmp = Compare()) {
+    assert(&out != &a && &out != &b);
+    const size_t old_size = out.Size();
+    const size_t bound = std::min(a.Size(), b.Size());
+    if constexpr (std::is_trivial_v<T>) {
+        // Результат пишется прямо в неинициализированный хвост, который затем обрезается
+        T* result = out.AppendUninitialized(bound);
+        out.Resize(old_size + set_detail::IntersectInto(a.begin(), a.Size(), b.begin(), b.Size(), result, cmp));
+    } else {
+        out.Reserve(old_size + bound);
+        set_detail::Intersect(a.begin(), a.Size(), b.begin(), b.Size(), cmp, [&out](const T& value) {
+            out.PushBack(value);
+        });
+    }
+    return out.Size() - old_size;
+}
+
+// Элементы a, которых нет в b. Возвращает число добавленных в out элементов
+template <typename T, typename Compare = std::less<>>
+size_t SetDifference(const Vector<T>& a, const Vector<T>& b, Vector<T>& out, Compare cmp = Compare()) {
+    assert(&out != &a && &out != &b);
+    const size_t old_size = out.Size();
+    out.Reserve(old_size + a.Size());
+    set_detail::Difference(a.begin(), a.Size(), b.begin(), b.Size(), out, cmp);
+    return out.Size() - old_size;
+}
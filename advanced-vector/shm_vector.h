@@ -0,0 +1,189 @@
+#pragma once
+#include "mmap_vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Вектор в разделяемой памяти POSIX (shm_open). Один процесс наполняет его
+ * через MmapVector, остальные отображают тот же сегмент только для чтения,
+ * так что на машине хранится одна копия данных. Элементы адресуются смещением
+ * от начала сегмента и не зависят от адреса отображения в процессе.
+ */
+
+// Создаёт сегмент name (начинается с '/'), отбрасывая прежнее содержимое,
+// и возвращает вектор для его наполнения
+template <typename T>
+MmapVector<T> CreateSharedVector(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        ThrowSystemError("shm_open");
+    }
+    return MmapVector<T>(fd);
+}
+
+// Удаляет имя сегмента; уже открытые отображения остаются действительными
+inline void RemoveSharedVector(const std::string& name) {
+    if (::shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+        ThrowSystemError("shm_unlink");
+    }
+}
+
+template <typename T>
+class SharedVectorReader {
+    static_assert(std::is_trivially_copyable_v<T>, "SharedVectorReader requires a trivially copyable type");
+
+public:
+    /**
+     * Конструкторы
+     */
+    explicit SharedVectorReader(const std::string& name) {
+        fd_ = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd_ == -1) {
+            ThrowSystemError("shm_open");
+        }
+        try {
+            Map();
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+        if (header_->magic != MappedVectorHeader::MAGIC || header_->element_size != sizeof(T)) {
+            ::munmap(const_cast<MappedVectorHeader*>(header_), mapped_bytes_);
+            ::close(fd_);
+            throw std::runtime_error("Not a shared vector of this element type");
+        }
+    }
+
+    SharedVectorReader(const SharedVectorReader&) = delete;
+    SharedVectorReader& operator=(const SharedVectorReader&) = delete;
+
+    SharedVectorReader(SharedVectorReader&& other) noexcept {
+        Swap(other);
+    }
+
+    SharedVectorReader& operator=(SharedVectorReader&& rhs) noexcept {
+        if (this != &rhs) {
+            SharedVectorReader moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    ~SharedVectorReader() {
+        if (header_ != nullptr) {
+            ::munmap(const_cast<MappedVectorHeader*>(header_), mapped_bytes_);
+        }
+        if (fd_ != -1) {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * Итераторы
+     */
+
+    using const_iterator = const T*;
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + Size();
+    }
+
+    /**
+     * Операторы
+     */
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    /**
+     * Методы
+     */
+
+    void Swap(SharedVectorReader& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(header_, other.header_);
+        std::swap(mapped_bytes_, other.mapped_bytes_);
+    }
+
+    // Число опубликованных писателем элементов, попадающих в текущее отображение.
+    // Если писатель расширил сегмент, новые элементы станут видны после Refresh()
+    size_t Size() const noexcept {
+        // Перемещённый читатель ничего не отображает и пуст
+        if (header_ == nullptr) {
+            return 0;
+        }
+        const size_t capacity = (mapped_bytes_ - MmapVector<T>::DATA_OFFSET) / sizeof(T);
+        return std::min<size_t>(header_->size.load(std::memory_order_acquire), capacity);
+    }
+
+    ConstVectorView<T> View() const noexcept {
+        return ConstVectorView<T>(Data(), Size());
+    }
+
+    // Переотображает сегмент, если писатель его расширил
+    void Refresh() {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            ThrowSystemError("fstat");
+        }
+        if (static_cast<size_t>(st.st_size) == mapped_bytes_) {
+            return;
+        }
+        SharedVectorReader fresh;
+        fresh.fd_ = ::dup(fd_);
+        if (fresh.fd_ == -1) {
+            ThrowSystemError("dup");
+        }
+        fresh.Map();
+        Swap(fresh);
+    }
+
+private:
+    int fd_ = -1;
+    const MappedVectorHeader* header_ = nullptr;
+    size_t mapped_bytes_ = 0;
+
+    SharedVectorReader() = default;
+
+    const T* Data() const noexcept {
+        if (header_ == nullptr) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(reinterpret_cast<const char*>(header_) + MmapVector<T>::DATA_OFFSET);
+    }
+
+    void Map() {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            ThrowSystemError("fstat");
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes < MmapVector<T>::DATA_OFFSET) {
+            throw std::runtime_error("Shared vector segment is not initialized");
+        }
+        void* addr = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        header_ = static_cast<const MappedVectorHeader*>(addr);
+        mapped_bytes_ = bytes;
+    }
+};
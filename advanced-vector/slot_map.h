@@ -0,0 +1,203 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+/*
+ * Хранилище со стабильными ключами. Значения лежат плотно в Vector и
+ * перебираются подряд; ключ (Handle) указывает на ячейку таблицы слотов,
+ * которая хранит текущую позицию значения. Удаление переносит последнее
+ * значение на место удалённого за O(1) и увеличивает поколение слота,
+ * поэтому ключи удалённых значений перестают находить что-либо, даже когда
+ * слот занят заново. Освобождённые слоты переиспользуются через список свободных.
+ */
+template <typename T>
+class SlotMap {
+public:
+    struct Handle {
+        uint32_t index = 0;
+        // Поколение 0 не выдаётся, поэтому Handle{} никогда не действителен
+        uint32_t generation = 0;
+
+        friend bool operator==(Handle lhs, Handle rhs) noexcept {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        friend bool operator!=(Handle lhs, Handle rhs) noexcept {
+            return !(lhs == rhs);
+        }
+    };
+
+    /**
+     * Итераторы
+     */
+
+    // Перебор значений в плотном порядке, который меняется при удалении
+    using iterator = typename Vector<T>::iterator;
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    iterator begin() noexcept {
+        return values_.begin();
+    }
+
+    iterator end() noexcept {
+        return values_.end();
+    }
+
+    const_iterator begin() const noexcept {
+        return values_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return values_.end();
+    }
+
+    /**
+     * Операторы
+     */
+
+    const T& operator[](Handle handle) const noexcept {
+        return const_cast<SlotMap&>(*this)[handle];
+    }
+
+    T& operator[](Handle handle) noexcept {
+        assert(Contains(handle));
+        return values_[slots_[handle.index].position];
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return values_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return values_.Size() == 0;
+    }
+
+    void Reserve(size_t capacity) {
+        values_.Reserve(capacity);
+        owners_.Reserve(capacity);
+        slots_.Reserve(capacity);
+    }
+
+    template <typename... Args>
+    Handle Emplace(Args&&... args) {
+        const uint32_t index = AcquireSlot();
+        values_.EmplaceBack(std::forward<Args>(args)...);
+        try {
+            owners_.PushBack(index);
+        } catch (...) {
+            values_.PopBack();
+            throw;
+        }
+        Slot& slot = slots_[index];
+        free_head_ = slot.position;
+        slot.position = static_cast<uint32_t>(values_.Size() - 1);
+        return Handle{index, slot.generation};
+    }
+
+    template <typename B>
+    Handle Insert(B&& value) {
+        return Emplace(std::forward<B>(value));
+    }
+
+    // Поколение свободного слота совпадает с поколением будущего ключа, а его позиция
+    // хранит ссылку списка свободных, поэтому занятость слота проверяется через owners_
+    bool Contains(Handle handle) const noexcept {
+        if (handle.index >= slots_.Size() || handle.generation == 0) {
+            return false;
+        }
+        const Slot& slot = slots_[handle.index];
+        return slot.generation == handle.generation && slot.position < owners_.Size()
+            && owners_[slot.position] == handle.index;
+    }
+
+    // Указатель на значение или nullptr, если ключ устарел
+    T* Find(Handle handle) noexcept {
+        return Contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+    }
+
+    const T* Find(Handle handle) const noexcept {
+        return const_cast<SlotMap&>(*this).Find(handle);
+    }
+
+    // Удаляет значение; возвращает false, если ключ устарел
+    bool Erase(Handle handle) {
+        if (!Contains(handle)) {
+            return false;
+        }
+        const uint32_t position = slots_[handle.index].position;
+        values_.EraseUnordered(values_.begin() + position);
+        owners_.EraseUnordered(owners_.begin() + position);
+        if (position != values_.Size()) {
+            slots_[owners_[position]].position = position;
+        }
+        ReleaseSlot(handle.index);
+        return true;
+    }
+
+    // Ключ значения, стоящего на позиции position плотного порядка
+    Handle HandleAt(size_t position) const noexcept {
+        assert(position < values_.Size());
+        const uint32_t index = owners_[position];
+        return Handle{index, slots_[index].generation};
+    }
+
+    ConstVectorView<T> Values() const noexcept {
+        return values_;
+    }
+
+    // Удаляет все значения; ключи всех удалённых значений становятся недействительными
+    void Clear() noexcept {
+        for (const uint32_t index : owners_) {
+            ReleaseSlot(index);
+        }
+        values_.Resize(0);
+        owners_.Resize(0);
+    }
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        // Поколение занятого слота; у свободного - поколение, которое получит следующий ключ
+        uint32_t generation = 1;
+        // Позиция значения в values_ у занятого слота, следующий свободный слот у свободного
+        uint32_t position = NONE;
+    };
+
+    Vector<T> values_;
+    // Номер слота для каждого значения, в том же порядке, что и values_
+    Vector<uint32_t> owners_;
+    Vector<Slot> slots_;
+    uint32_t free_head_ = NONE;
+
+    // Возвращает свободный слот, оставляя его в списке свободных до успешной вставки
+    uint32_t AcquireSlot() {
+        if (free_head_ != NONE) {
+            return free_head_;
+        }
+        assert(slots_.Size() < NONE);
+        slots_.PushBack(Slot{});
+        free_head_ = static_cast<uint32_t>(slots_.Size() - 1);
+        return free_head_;
+    }
+
+    void ReleaseSlot(uint32_t index) noexcept {
+        Slot& slot = slots_[index];
+        // Слот с исчерпанными поколениями больше не выдаётся, чтобы старые ключи не ожили
+        if (++slot.generation == 0) {
+            slot.position = NONE;
+            return;
+        }
+        slot.position = free_head_;
+        free_head_ = index;
+    }
+};
@@ -0,0 +1,289 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Сортировка Vector. Большие векторы целых и чисел с плавающей точкой
+ * сортируются поразрядно (LSD radix sort по байтам) через буфер RawMemory
+ * того же размера: число проходов равно размеру ключа в байтах, а проходы,
+ * в которых у всех элементов одинаковый байт, пропускаются. Небольшие векторы
+ * и остальные типы сортируются std::sort.
+ *
+ * Числа с плавающей точкой переводятся в беззнаковые ключи с тем же
+ * порядком: у неотрицательных инвертируется знаковый бит, у отрицательных -
+ * все биты. В таком порядке -0.0 идёт перед 0.0, а NaN с установленным
+ * знаком - перед -inf, остальные NaN - после +inf.
+ *
+ * ParallelSort делит вектор на части по числу потоков, сортирует их
+ * параллельно и затем сливает попарно в несколько раундов через буфер
+ * RawMemory. Каждое слияние делится между потоками по позициям результата
+ * (двоичный поиск точки раздела), поэтому параллельны и последние раунды,
+ * где сливаемых пар меньше, чем потоков.
+ */
+
+namespace sort_detail {
+
+// Меньше этого размера поразрядная сортировка проигрывает сортировке сравнениями
+inline constexpr size_t RADIX_THRESHOLD = 256;
+
+template <typename K>
+inline constexpr bool IS_RADIX_KEY = (std::is_integral_v<K> && !std::is_same_v<K, bool>)
+                                     || (std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+// Беззнаковый ключ, порядок которого совпадает с порядком k
+template <typename K>
+auto RadixKey(K k) noexcept {
+    static_assert(IS_RADIX_KEY<K>, "Radix keys must be integers or float/double");
+    if constexpr (std::is_floating_point_v<K>) {
+        using Bits = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+        Bits bits;
+        std::memcpy(&bits, &k, sizeof(K));
+        constexpr Bits SIGN = Bits{1} << (sizeof(K) * 8 - 1);
+        return (bits & SIGN) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | SIGN);
+    } else {
+        using Bits = std::make_unsigned_t<K>;
+        auto bits = static_cast<Bits>(k);
+        if constexpr (std::is_signed_v<K>) {
+            bits ^= Bits{1} << (sizeof(K) * 8 - 1);
+        }
+        return bits;
+    }
+}
+
+// Устойчивая поразрядная сортировка n элементов по беззнаковому ключу key(element)
+template <typename T, typename KeyFn>
+void RadixSort(T* data, size_t n, KeyFn key) {
+    static_assert(std::is_trivially_copyable_v<T>, "RadixSort moves elements as raw bytes");
+    using Key = decltype(key(*data));
+    constexpr size_t PASSES = sizeof(Key);
+    constexpr size_t DIGITS = 256;
+
+    // Гистограммы всех разрядов строятся за один проход
+    size_t counts[PASSES][DIGITS] = {};
+    for (size_t i = 0; i < n; ++i) {
+        const Key k = key(data[i]);
+        for (size_t pass = 0; pass < PASSES; ++pass) {
+            ++counts[pass][(k >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    RawMemory<T> scratch(n);
+    T* from = data;
+    T* to = scratch.GetAddress();
+    for (size_t pass = 0; pass < PASSES; ++pass) {
+        size_t* count = counts[pass];
+        if (count[(key(from[0]) >> (pass * 8)) & 0xFF] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < DIGITS; ++digit) {
+            offset += std::exchange(count[digit], offset);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            std::memcpy(to + count[(key(from[i]) >> (pass * 8)) & 0xFF]++, from + i, sizeof(T));
+        }
+        std::swap(from, to);
+    }
+    if (from != data) {
+        std::memcpy(data, from, n * sizeof(T));
+    }
+}
+
+/**
+ * Параллельная сортировка
+ */
+
+// Меньшие части сортируются быстрее, чем запускается поток
+inline constexpr size_t MIN_PARALLEL_CHUNK = 4096;
+
+// Выполняет fn(0) ... fn(tasks - 1), задачи с 1 - в отдельных потоках. Если поток
+// не удаётся создать, его задача выполняется в текущем: прерывать раунд нельзя
+template <typename Fn>
+void ForkJoin(size_t tasks, const Fn& fn) {
+    Vector<std::thread> workers;
+    workers.Reserve(tasks);
+    for (size_t task = 1; task < tasks; ++task) {
+        try {
+            workers.EmplaceBack(std::cref(fn), task);
+        } catch (const std::system_error&) {
+            fn(task);
+        }
+    }
+    fn(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Сколько элементов первой последовательности входит в первые k элементов их
+// слияния. При равенстве первыми идут элементы a, что сохраняет устойчивость
+template <typename T, typename Compare>
+size_t MergeSplit(const T* a, size_t na, const T* b, size_t nb, size_t k, Compare& cmp) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = std::min(k, na);
+    while (lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        if (!cmp(b[k - i - 1], a[i])) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Перемещает слияние a[i0, i1) и b[j0, j1) в неинициализированную память out
+template <typename T, typename Compare>
+void MergeInto(T* a, size_t i0, size_t i1, T* b, size_t j0, size_t j1, T* out, Compare& cmp) noexcept {
+    while (i0 < i1 && j0 < j1) {
+        T& next = cmp(b[j0], a[i0]) ? b[j0++] : a[i0++];
+        vector_detail::ConstructAt(out++, std::move(next));
+    }
+    for (; i0 < i1; ++i0) {
+        vector_detail::ConstructAt(out++, std::move(a[i0]));
+    }
+    for (; j0 < j1; ++j0) {
+        vector_detail::ConstructAt(out++, std::move(b[j0]));
+    }
+}
+
+template <typename T, typename Compare>
+void ParallelSort(Vector<T>& v, Compare cmp, size_t threads, bool stable) {
+    const auto sort_range = [&cmp, stable](T* first, T* last) {
+        stable ? std::stable_sort(first, last, cmp) : std::sort(first, last, cmp);
+    };
+    const size_t n = v.Size();
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    const size_t chunks = std::min(threads, n / MIN_PARALLEL_CHUNK);
+    // Элементы переезжают между буферами перемещением, которое не должно бросать
+    if (chunks <= 1 || !std::is_nothrow_move_constructible_v<T>) {
+        sort_range(v.begin(), v.end());
+        return;
+    }
+
+    // Границы отсортированных серий: серия r занимает [runs[r], runs[r + 1])
+    Vector<size_t> runs;
+    runs.Reserve(chunks + 1);
+    for (size_t chunk = 0; chunk <= chunks; ++chunk) {
+        runs.PushBack(chunk * n / chunks);
+    }
+    ForkJoin(chunks, [&](size_t chunk) {
+        sort_range(v.begin() + runs[chunk], v.begin() + runs[chunk + 1]);
+    });
+
+    RawMemory<T> scratch(n);
+    T* from = v.begin();
+    T* to = scratch.GetAddress();
+    Vector<size_t> merged;
+    merged.Reserve(chunks + 1);
+    while (runs.Size() > 2) {
+        const size_t pairs = (runs.Size() - 1) / 2;
+        // Каждое слияние делится на parts частей равной длины по результату;
+        // серия без пары просто переносится одной задачей
+        const size_t parts = std::max<size_t>(threads / pairs, 1);
+        const bool odd = (runs.Size() - 1) % 2 == 1;
+        ForkJoin(pairs * parts + odd, [&](size_t task) {
+            const size_t pair = task / parts;
+            if (pair == pairs) {
+                const size_t begin = runs[runs.Size() - 2];
+                const size_t end = runs[runs.Size() - 1];
+                for (size_t i = begin; i < end; ++i) {
+                    vector_detail::ConstructAt(to + i, std::move(from[i]));
+                }
+                return;
+            }
+            const size_t begin = runs[2 * pair];
+            const size_t middle = runs[2 * pair + 1];
+            const size_t end = runs[2 * pair + 2];
+            T* a = from + begin;
+            T* b = from + middle;
+            const size_t na = middle - begin;
+            const size_t nb = end - middle;
+            const size_t part = task % parts;
+            const size_t k0 = part * (na + nb) / parts;
+            const size_t k1 = (part + 1) * (na + nb) / parts;
+            const size_t i0 = MergeSplit(a, na, b, nb, k0, cmp);
+            const size_t i1 = MergeSplit(a, na, b, nb, k1, cmp);
+            MergeInto(a, i0, i1, b, k0 - i0, k1 - i1, to + begin + k0, cmp);
+        });
+        std::destroy_n(from, n);
+        std::swap(from, to);
+
+        merged.Resize(0);
+        for (size_t r = 0; r < runs.Size(); r += 2) {
+            merged.PushBack(runs[r]);
+        }
+        if (odd) {
+            merged.PushBack(n);
+        }
+        runs.Swap(merged);
+    }
+    if (from != v.begin()) {
+        vector_detail::RelocateN(from, n, v.begin());
+        std::destroy_n(from, n);
+    }
+}
+
+}  // namespace sort_detail
+
+// Сортирует по возрастанию; целые и float/double - поразрядно, если их много
+template <typename T>
+void Sort(Vector<T>& v) {
+    if constexpr (sort_detail::IS_RADIX_KEY<T>) {
+        if (v.Size() >= sort_detail::RADIX_THRESHOLD) {
+            sort_detail::RadixSort(v.begin(), v.Size(), [](T value) {
+                return sort_detail::RadixKey(value);
+            });
+            return;
+        }
+    }
+    std::sort(v.begin(), v.end());
+}
+
+template <typename T, typename Compare>
+void Sort(Vector<T>& v, Compare cmp) {
+    std::sort(v.begin(), v.end(), cmp);
+}
+
+// Устойчиво сортирует по ключу key(element) - целому или float/double.
+// Тривиально копируемые элементы большого вектора сортируются поразрядно
+template <typename T, typename KeyFn>
+void SortByKey(Vector<T>& v, KeyFn key) {
+    const auto radix_key = [&key](const T& value) {
+        return sort_detail::RadixKey(key(value));
+    };
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (v.Size() >= sort_detail::RADIX_THRESHOLD) {
+            sort_detail::RadixSort(v.begin(), v.Size(), radix_key);
+            return;
+        }
+    }
+    std::stable_sort(v.begin(), v.end(), [&radix_key](const T& lhs, const T& rhs) {
+        return radix_key(lhs) < radix_key(rhs);
+    });
+}
+
+// Сортирует части вектора в threads потоках (0 - по числу аппаратных потоков) и
+// сливает их параллельно. Сравнение вызывается из разных потоков одновременно и
+// не должно бросать исключений
+template <typename T, typename Compare = std::less<>>
+void ParallelSort(Vector<T>& v, Compare cmp = Compare(), size_t threads = 0) {
+    sort_detail::ParallelSort(v, cmp, threads, false);
+}
+
+// Устойчивый вариант ParallelSort: равные элементы сохраняют исходный порядок
+template <typename T, typename Compare = std::less<>>
+void ParallelStableSort(Vector<T>& v, Compare cmp = Compare(), size_t threads = 0) {
+    sort_detail::ParallelSort(v, cmp, threads, true);
+}
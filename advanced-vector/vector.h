@@ -1,93 +1,287 @@
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <new>
+#include <type_traits>
 #include <utility>
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef ADVANCED_VECTOR_TRACE
+#include "growth_trace.h"
+#endif
+#ifdef ADVANCED_VECTOR_ADAPTIVE_CAPACITY
+#include "capacity_hints.h"
+#endif
+#if defined(ADVANCED_VECTOR_TRACE) || defined(ADVANCED_VECTOR_ADAPTIVE_CAPACITY)
+#define ADVANCED_VECTOR_CALL_SITES 1
+#include <source_location>
+#endif
+
+/*
+ * В C++20 RawMemory и Vector пригодны для вычислений во время компиляции:
+ * память выделяется через std::allocator, объекты создаются std::construct_at,
+ * а memcpy и неинициализированные алгоритмы заменяются поэлементными циклами.
+ * В C++17 функции остаются обычными, а код, выполняемый во время работы, тот же.
+ */
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 1
+#define ADVANCED_VECTOR_CONSTEXPR constexpr
+#else
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 0
+#define ADVANCED_VECTOR_CONSTEXPR
+#endif
+
+namespace vector_detail {
+
+// Истинно при вычислении во время компиляции; в C++17 всегда ложно
+constexpr bool IsConstantEvaluated() noexcept {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Создаёт объект в сырой памяти по адресу p
+template <typename T, typename... Args>
+ADVANCED_VECTOR_CONSTEXPR T* ConstructAt(T* p, Args&&... args) {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::construct_at(p, std::forward<Args>(args)...);
+#else
+    return new (p) T(std::forward<Args>(args)...);
+#endif
+}
+
+// Переносятся ли элементы при реаллокации перемещением (иначе копированием)
+template <typename T>
+inline constexpr bool RELOCATES_BY_MOVE = std::is_trivially_copyable_v<T>
+    || std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+// Копирует n элементов из src в сырую память dst. Тривиально копируемые
+// элементы копируются одним memcpy: libc выбирает его реализацию под
+// процессор при запуске (AVX, rep movsb, невременные записи для больших блоков)
+template <typename T>
+ADVANCED_VECTOR_CONSTEXPR void CopyN(const T* src, size_t n, T* dst) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            ConstructAt(dst + i, src[i]);
+        }
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+        if (n != 0) {
+            std::memcpy(dst, src, n * sizeof(T));
+        }
+    } else {
+        std::uninitialized_copy_n(src, n, dst);
+    }
+}
+
+// Переносит n элементов из src в сырую память dst: перемещает, если
+// перемещение не бросает исключений, иначе копирует. Исходные элементы
+// остаются живыми и разрушаются вызывающей стороной
+template <typename T>
+ADVANCED_VECTOR_CONSTEXPR void RelocateN(T* src, size_t n, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T> || !RELOCATES_BY_MOVE<T>) {
+        CopyN(src, n, dst);
+    } else if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            ConstructAt(dst + i, std::move(src[i]));
+        }
+    } else {
+        std::uninitialized_move_n(src, n, dst);
+    }
+}
+
+// Создаёт n объектов со значением по умолчанию в сырой памяти dst
+template <typename T>
+ADVANCED_VECTOR_CONSTEXPR void ValueConstructN(T* dst, size_t n) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            ConstructAt(dst + i);
+        }
+    } else {
+        std::uninitialized_value_construct_n(dst, n);
+    }
+}
+
+}  // namespace vector_detail
 
 template <typename T>
 class RawMemory {
 public:
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
+    ADVANCED_VECTOR_CONSTEXPR explicit RawMemory(size_t capacity)
         : buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
+    // Принимает во владение внешний буфер: вместо operator delete
+    // память будет освобождена вызовом deleter(buffer). Если принять буфер
+    // не удалось, первые constructed объектов в нём разрушаются до освобождения
+    template <typename Deleter>
+    RawMemory(T* buffer, size_t capacity, Deleter deleter, size_t constructed)
+        : buffer_(buffer)
+        , capacity_(capacity) {
+        try {
+            owner_ = new ExternalOwner<Deleter>(std::move(deleter));
+        } catch (...) {
+            std::destroy_n(buffer, constructed);
+            deleter(buffer);
+            throw;
+        }
+    }
+
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
-    RawMemory(RawMemory&& other) noexcept {
-        capacity_ = other.capacity_;
-        other.capacity_ = 0;
-        buffer_ = other.buffer_;
-        other.buffer_ = nullptr;
+    ADVANCED_VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept {
+        Swap(other);
     }
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
         if (this != &rhs) {
-            buffer_ = std::move(rhs.buffer_);
-            capacity_ = std::move(rhs.capacity_);
-            rhs.buffer_ = nullptr;
-            rhs.capacity_ = 0;
+            RawMemory moved(std::move(rhs));
+            Swap(moved);
         }
         return *this;
     }
     
-    T* operator+(size_t offset) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
+        std::swap(owner_, other.owner_);
     }
 
-    const T* GetAddress() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const {
         return capacity_;
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    ADVANCED_VECTOR_CONSTEXPR ~RawMemory() {
+        if (owner_ != nullptr) {
+            owner_->Release(buffer_);
+            delete owner_;
+        } else {
+            Deallocate(buffer_, capacity_);
+        }
     }
 
 private:
-    // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    // Владелец внешнего буфера, хранящий пользовательский deleter
+    struct ExternalOwnerBase {
+        virtual void Release(T* buffer) noexcept = 0;
+        virtual ~ExternalOwnerBase() = default;
+    };
+
+    template <typename Deleter>
+    struct ExternalOwner final : ExternalOwnerBase {
+        explicit ExternalOwner(Deleter deleter)
+            : deleter(std::move(deleter)) {
+        }
+
+        void Release(T* buffer) noexcept override {
+            deleter(buffer);
+        }
+
+        Deleter deleter;
+    };
+
+    // Выделяет сырую память под n элементов и возвращает указатель на неё.
+    // std::allocator учитывает выравнивание T и допустим при вычислениях во время компиляции
+    static ADVANCED_VECTOR_CONSTEXPR T* Allocate(size_t n) {
+        return n != 0 ? std::allocator<T>().allocate(n) : nullptr;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    static ADVANCED_VECTOR_CONSTEXPR void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            std::allocator<T>().deallocate(buf, n);
+        }
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    ExternalOwnerBase* owner_ = nullptr;
+};
+
+/*
+ * Место вызова, которому приписывается рост вектора. При ADVANCED_VECTOR_TRACE
+ * или ADVANCED_VECTOR_ADAPTIVE_CAPACITY это std::source_location: рост попадает
+ * в отчёт growth_trace, а место конструирования служит ключом capacity_hints.
+ * Иначе это пустой тип, и параметры по умолчанию ничего не стоят.
+ */
+#ifdef ADVANCED_VECTOR_CALL_SITES
+using VectorCallSite = std::source_location;
+#else
+struct VectorCallSite {
+    static constexpr VectorCallSite current() noexcept {
+        return {};
+    }
+};
+#endif
+
+namespace vector_detail {
+
+// Место вызова конструктора по умолчанию. Инициализатор члена вычисляется там,
+// где создаётся метка, то есть в месте вызова конструктора Vector
+struct DefaultConstructionSite {
+    VectorCallSite site = VectorCallSite::current();
+};
+
+}  // namespace vector_detail
+
+/*
+ * Счётчики операций Vector, помогающие найти вектора, которые слишком часто
+ * перевыделяют память. Собираются, только если определён макрос
+ * ADVANCED_VECTOR_STATS; без него счётчики не хранятся и не обновляются.
+ */
+struct VectorStats {
+#ifdef ADVANCED_VECTOR_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    // Выделения нового буфера с переносом в него существующих элементов
+    size_t reallocations = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t peak_capacity = 0;
+    // Выделенные, но не занятые элементами ячейки на момент запроса
+    size_t wasted_capacity = 0;
 };
 
 template <typename T>
@@ -97,22 +291,51 @@ public:
     /**
      * Конструкторы
      */
-    Vector() = default;
+    // Место вызова конструктора запоминается: ему приписывается рост через
+    // Emplace и EmplaceBack, которые не могут принять место вызова параметром
+    ADVANCED_VECTOR_CONSTEXPR Vector(vector_detail::DefaultConstructionSite site = {}) noexcept {
+        RememberSite(site.site);
+    }
 
-    explicit Vector(size_t size)
+    // Явное место вызова не превращается в вектор неявно
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(VectorCallSite site) noexcept {
+        RememberSite(site);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(size_t size, VectorCallSite site = VectorCallSite::current())
         : data_(size)
         , size_(size) {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size_);
+        vector_detail::ValueConstructN(data_.GetAddress(), size_);
+        CountAllocation(size);
+        RememberSite(site);
     }
 
-    Vector(Vector&& other) noexcept {
+    // Размер перемещаемого вектора учитывается как итоговый для его места конструирования
+    ADVANCED_VECTOR_CONSTEXPR Vector(Vector&& other, VectorCallSite site = VectorCallSite::current()) noexcept {
+        other.LearnFinalSize();
         Swap(other);
+        RememberSite(site);
+    }
+
+    // Принимает во владение size уже сконструированных элементов во внешнем буфере.
+    // Элементы разрушаются вектором, а память освобождается вызовом deleter(data)
+    // при уничтожении вектора или при переезде в новый буфер. Если конструктор
+    // бросает, элементы уже разрушены, а буфер освобождён
+    template <typename Deleter>
+    Vector(T* data, size_t size, Deleter deleter, VectorCallSite site = VectorCallSite::current())
+        : data_(data, size, std::move(deleter), size)
+        , size_(size) {
+        RememberSite(site);
     }
 
-    Vector(const Vector& other)
+    // Размер берётся из ёмкости нового буфера, а не перечитывается из other после
+    // выделения памяти: иначе GCC на -O3 не связывает его с проверкой в CopyN
+    ADVANCED_VECTOR_CONSTEXPR Vector(const Vector& other, VectorCallSite site = VectorCallSite::current())
         : data_(other.size_)
-        , size_(other.size_) {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+        , size_(data_.Capacity()) {
+        vector_detail::CopyN(other.data_.GetAddress(), size_, data_.GetAddress());
+        CountAllocation(size_);
+        RememberSite(site);
     }
 
     /**
@@ -122,27 +345,27 @@ public:
     using iterator = T*;
     using const_iterator = const T*;
 
-    iterator begin() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR iterator begin() noexcept {
         return data_.GetAddress();
     }
 
-    iterator end() noexcept {
+    ADVANCED_VECTOR_CONSTEXPR iterator end() noexcept {
         return data_.GetAddress() + size_;
     }
 
-    const_iterator begin() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator begin() const noexcept {
         return data_.GetAddress();
     }
 
-    const_iterator end() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator end() const noexcept {
         return data_.GetAddress() + size_;
     }
 
-    const_iterator cbegin() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
         return begin();
     }
 
-    const_iterator cend() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cend() const noexcept {
         return end();
     }
 
@@ -150,21 +373,27 @@ public:
      * Операторы
      */
 
-    Vector& operator=(const Vector& rhs) {
+    ADVANCED_VECTOR_CONSTEXPR Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
             if (rhs.size_ > data_.Capacity()) {
                 /* Применить copy-and-swap */
-                Vector rhs_copy(rhs);
+                // У временной копии нет места конструирования: её размер не должен
+                // попасть в подсказки ёмкости под строкой этого оператора
+                Vector rhs_copy(rhs, VectorCallSite{});
                 Swap(rhs_copy);
+                // Счётчики не обмениваются, поэтому выделение копии учитывается здесь
+                CountAllocation(size_);
             } else {
                 /* Скопировать элементы из rhs, создав при необходимости новые
                    или удалив существующие */
-                if (rhs.size_ < size_) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    vector_detail::CopyN(rhs.data_.GetAddress(), rhs.size_, data_.GetAddress());
+                } else if (rhs.size_ < size_) {
                     std::copy_n(rhs.data_.GetAddress(), rhs.size_, data_.GetAddress());
                     std::destroy_n(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
                 } else {
                     std::copy_n(rhs.data_.GetAddress(), size_, data_.GetAddress());
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
+                    vector_detail::CopyN(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
                 }
                 size_ = rhs.size_;
             }
@@ -172,19 +401,20 @@ public:
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR Vector& operator=(Vector&& rhs) noexcept {
         if (this == &rhs) {
             return *this;
         }
+        rhs.LearnFinalSize();
         Swap(rhs);
         return *this;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < size_);
         return data_[index];
     }
@@ -193,76 +423,40 @@ public:
      * Методы
      */
 
-    void Swap(Vector& other) noexcept {
+    ADVANCED_VECTOR_CONSTEXPR void Swap(Vector& other) noexcept {
         std::swap(size_, other.size_);
         data_.Swap(other.data_);
     }
 
-    size_t Size() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    void PopBack() /* noexcept */ {
+    ADVANCED_VECTOR_CONSTEXPR void PopBack() /* noexcept */ {
         if (size_ < 1) {
             return;
         }
-        std::destroy_at(data_.GetAddress() + size_--);
+        std::destroy_at(data_.GetAddress() + --size_);
     };
 
-    template<typename ...Args>
-    iterator Emplace(const_iterator pos, Args && ...args) {
-        assert(pos >= begin() && pos <= end());
-
-        size_t index = pos - begin();
-
-        if (data_.Capacity() > size_) {
-            try {
-                if (pos != end()) {
-                    T new_s(std::forward<Args>(args)...);
-                    new (end()) T(std::forward<T>(data_[size_ - 1]));
-
-                    std::move_backward(begin() + index, end() - 1, end());
-                    *(begin() + index) = std::forward<T>(new_s);
-                } else {
-                    new (end()) T(std::forward<Args>(args)...);
-                }
-            } catch (...) {
-                operator delete (end());
-                throw;
-            }
-        } else {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-
-            new (new_data.GetAddress() + index) T(std::forward<Args>(args)...);
-
-            if constexpr (!std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>) {
-                std::uninitialized_copy_n(data_.GetAddress(), index, new_data.GetAddress());
-                std::uninitialized_copy_n(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
-            } else {
-                std::uninitialized_move_n(data_.GetAddress(), index, new_data.GetAddress());
-                std::uninitialized_move_n(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
-            }
-
-            std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(new_data);
-        }
-        size_++;
-        return begin() + index;
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR iterator Emplace(const_iterator pos, Args&&... args) {
+        return EmplaceAt(ConstructionSite(), pos, std::forward<Args>(args)...);
     }
 
-    iterator Insert(const_iterator pos, const T& value) {
-        return Emplace(pos, value);
+    ADVANCED_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, const T& value, VectorCallSite site = VectorCallSite::current()) {
+        return EmplaceAt(site, pos, value);
     };
 
-    iterator Insert(const_iterator pos, T&& value) {
-        return Emplace(pos, std::move(value));
+    ADVANCED_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, T&& value, VectorCallSite site = VectorCallSite::current()) {
+        return EmplaceAt(site, pos, std::move(value));
     };
 
-    iterator Erase(const_iterator pos) {
+    ADVANCED_VECTOR_CONSTEXPR iterator Erase(const_iterator pos) {
         assert(pos >= begin() && pos < end());
         size_t shift = pos - begin();
         std::move(begin() + shift + 1, end(), begin() + shift);
@@ -270,77 +464,258 @@ public:
         return begin() + shift;
     }
 
-    template<typename B>
-    void PushBack(B&& value) {
-        EmplaceBack(std::forward<B>(value));
+    // Удаляет элемент за O(1), перенося на его место последний; порядок не сохраняется.
+    // Возвращает итератор на элемент, занявший позицию pos (или end())
+    ADVANCED_VECTOR_CONSTEXPR iterator EraseUnordered(const_iterator pos) {
+        assert(pos >= begin() && pos < end());
+        size_t index = pos - begin();
+        if (index + 1 != size_) {
+            data_[index] = std::move(data_[size_ - 1]);
+        }
+        PopBack();
+        return begin() + index;
     }
 
-    template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
-        if (size_ != Capacity()) {
-            T* r = new (data_ + size_) T(std::forward<Args>(args)...);
-            size_++;
-            return *r;
-        }
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        T* result = new (new_data + size_) T(std::forward<Args>(args)...);
-        if constexpr (!std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>) {
-            try {
-                std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
-            }
-            catch (...) {
-                std::destroy_n(new_data.GetAddress() + size_, 1);
-                throw;
+    // Удаляет все элементы, для которых pred вернул true, заполняя дыры элементами
+    // с конца. Каждый элемент проверяется один раз; возвращает число удалённых
+    template <typename Predicate>
+    ADVANCED_VECTOR_CONSTEXPR size_t EraseUnorderedIf(Predicate pred) {
+        size_t index = 0;
+        size_t live = size_;
+        while (index < live) {
+            if (pred(std::as_const(data_[index]))) {
+                if (index + 1 != live) {
+                    data_[index] = std::move(data_[live - 1]);
+                }
+                --live;
+            } else {
+                ++index;
             }
-        } else {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
         }
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
-        ++size_;
-        return *result;
-    };
+        const size_t erased = size_ - live;
+        std::destroy_n(data_.GetAddress() + live, erased);
+        size_ = live;
+        return erased;
+    }
 
-    void Resize(size_t new_size) {
+    template <typename B>
+    ADVANCED_VECTOR_CONSTEXPR void PushBack(B&& value, VectorCallSite site = VectorCallSite::current()) {
+        EmplaceBackAt(site, std::forward<B>(value));
+    }
+
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
+        return EmplaceBackAt(ConstructionSite(), std::forward<Args>(args)...);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Resize(size_t new_size, VectorCallSite site = VectorCallSite::current()) {
         if (new_size == size_) {
             return;
         }
         if (new_size < size_) {
             std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
         } else {
-            Reserve(new_size);
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            Reserve(new_size, site);
+            vector_detail::ValueConstructN(data_.GetAddress() + size_, new_size - size_);
         }
         std::swap(size_, new_size);
     };
 
-    void Reserve(size_t new_capacity) {
+    ADVANCED_VECTOR_CONSTEXPR void Reserve(size_t new_capacity, VectorCallSite site = VectorCallSite::current()) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
         RawMemory<T> new_data(new_capacity);
 
-        // Конструируем элементы в new_data, копируя их из data_
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
-        }
+        // Конструируем элементы в new_data, перемещая или копируя их из data_
+        vector_detail::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
 
         // Разрушаем элементы в data_
         std::destroy_n(data_.GetAddress(), size_);
 
         // Избавляемся от старой сырой памяти, обменивая её на новую
         data_.Swap(new_data);
+        CountAllocation(new_capacity);
+        CountRelocation(size_);
+        TraceGrowth(site, new_capacity, size_);
+    }
+
+    // Увеличивает размер на n элементов без их инициализации и возвращает указатель
+    // на первый из них. Вызывающая сторона обязана записать все n элементов
+    ADVANCED_VECTOR_CONSTEXPR T* AppendUninitialized(size_t n, VectorCallSite site = VectorCallSite::current()) {
+        static_assert(std::is_trivially_copyable_v<T>, "AppendUninitialized requires a trivially copyable type");
+        if (size_ + n > data_.Capacity()) {
+            Reserve(std::max(size_ + n, size_ * 2), site);
+        }
+        T* result = data_.GetAddress() + size_;
+        size_ += n;
+        return result;
     }
 
-    ~Vector() {
+    // Счётчики операций этого вектора; без ADVANCED_VECTOR_STATS все поля нулевые.
+    // Swap и перемещение не переносят счётчики между векторами
+    ADVANCED_VECTOR_CONSTEXPR VectorStats Stats() const noexcept {
+        VectorStats stats;
+#ifdef ADVANCED_VECTOR_STATS
+        stats = stats_;
+        stats.wasted_capacity = data_.Capacity() - size_;
+#endif
+        return stats;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR ~Vector() {
+        LearnFinalSize();
         std::destroy_n(data_.GetAddress(), size_);
     }
 
 private:
     RawMemory<T> data_;
     size_t size_ = 0;
+#ifdef ADVANCED_VECTOR_STATS
+    VectorStats stats_;
+#endif
+#ifdef ADVANCED_VECTOR_CALL_SITES
+    // Место конструирования; как и счётчики, не обменивается в Swap
+    VectorCallSite site_;
+#endif
+
+    static constexpr bool RELOCATES_BY_MOVE = vector_detail::RELOCATES_BY_MOVE<T>;
+
+    // Учитывает выделение буфера под capacity элементов
+    ADVANCED_VECTOR_CONSTEXPR void CountAllocation([[maybe_unused]] size_t capacity) noexcept {
+#ifdef ADVANCED_VECTOR_STATS
+        if (capacity == 0) {
+            return;
+        }
+        ++stats_.allocations;
+        stats_.bytes_allocated += capacity * sizeof(T);
+        stats_.peak_capacity = std::max(stats_.peak_capacity, capacity);
+#endif
+    }
+
+    // Учитывает перенос n элементов в новый буфер при реаллокации
+    ADVANCED_VECTOR_CONSTEXPR void CountRelocation([[maybe_unused]] size_t n) noexcept {
+#ifdef ADVANCED_VECTOR_STATS
+        if (n == 0) {
+            return;
+        }
+        ++stats_.reallocations;
+        (RELOCATES_BY_MOVE ? stats_.elements_moved : stats_.elements_copied) += n;
+#endif
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void RememberSite([[maybe_unused]] const VectorCallSite& site) noexcept {
+#ifdef ADVANCED_VECTOR_CALL_SITES
+        site_ = site;
+#endif
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR VectorCallSite ConstructionSite() const noexcept {
+#ifdef ADVANCED_VECTOR_CALL_SITES
+        return site_;
+#else
+        return {};
+#endif
+    }
+
+    // Сообщает capacity_hints итоговый размер и забывает место конструирования,
+    // чтобы содержимое, переданное другому вектору, не было учтено повторно
+    ADVANCED_VECTOR_CONSTEXPR void LearnFinalSize() noexcept {
+#ifdef ADVANCED_VECTOR_ADAPTIVE_CAPACITY
+        if (site_.line() != 0 && !vector_detail::IsConstantEvaluated()) {
+            capacity_hints::Record(site_, size_);
+            site_ = VectorCallSite{};
+        }
+#endif
+    }
+
+    // Ёмкость первого буфера, выделяемого EmplaceBack
+    ADVANCED_VECTOR_CONSTEXPR size_t InitialCapacity() const noexcept {
+#ifdef ADVANCED_VECTOR_ADAPTIVE_CAPACITY
+        if (vector_detail::IsConstantEvaluated()) {
+            return 1;
+        }
+        return std::max<size_t>(capacity_hints::Hint(site_), 1);
+#else
+        return 1;
+#endif
+    }
+
+    // Сообщает в growth_trace о выделении буфера под capacity элементов при росте
+    ADVANCED_VECTOR_CONSTEXPR void TraceGrowth([[maybe_unused]] const VectorCallSite& site, [[maybe_unused]] size_t capacity,
+                     [[maybe_unused]] size_t relocated) noexcept {
+#ifdef ADVANCED_VECTOR_TRACE
+        if (!vector_detail::IsConstantEvaluated()) {
+            growth_trace::Record(site, capacity * sizeof(T), relocated);
+        }
+#endif
+    }
+
+    // Emplace и EmplaceBack с явным местом вызова, которому приписывается реаллокация
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR iterator EmplaceAt([[maybe_unused]] const VectorCallSite& site, const_iterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+
+        size_t index = pos - begin();
+
+        if (data_.Capacity() > size_) {
+            if (pos != end()) {
+                T new_s(std::forward<Args>(args)...);
+                vector_detail::ConstructAt(end(), std::forward<T>(data_[size_ - 1]));
+
+                try {
+                    std::move_backward(begin() + index, end() - 1, end());
+                    *(begin() + index) = std::forward<T>(new_s);
+                } catch (...) {
+                    // Элемент за концом уже сконструирован, но ещё не учтён в size_
+                    std::destroy_at(end());
+                    throw;
+                }
+            } else {
+                vector_detail::ConstructAt(end(), std::forward<Args>(args)...);
+            }
+        } else {
+            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+
+            vector_detail::ConstructAt(new_data.GetAddress() + index, std::forward<Args>(args)...);
+
+            vector_detail::RelocateN(data_.GetAddress(), index, new_data.GetAddress());
+            vector_detail::RelocateN(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
+
+            std::destroy_n(data_.GetAddress(), size_);
+            data_.Swap(new_data);
+            CountAllocation(data_.Capacity());
+            CountRelocation(size_);
+            TraceGrowth(site, data_.Capacity(), size_);
+        }
+        size_++;
+        return begin() + index;
+    }
+
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR T& EmplaceBackAt([[maybe_unused]] const VectorCallSite& site, Args&&... args) {
+        if (size_ != Capacity()) {
+            T* r = vector_detail::ConstructAt(data_ + size_, std::forward<Args>(args)...);
+            size_++;
+            return *r;
+        }
+        RawMemory<T> new_data(size_ == 0 ? InitialCapacity() : size_ * 2);
+        T* result = vector_detail::ConstructAt(new_data + size_, std::forward<Args>(args)...);
+        try {
+            vector_detail::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+        catch (...) {
+            std::destroy_n(new_data.GetAddress() + size_, 1);
+            throw;
+        }
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.Swap(new_data);
+        CountAllocation(data_.Capacity());
+        CountRelocation(size_);
+        TraceGrowth(site, data_.Capacity(), size_);
+        ++size_;
+        return *result;
+    }
 
     // Вызывает деструкторы n объектов массива по адресу buf
     static void DestroyN(T* buf, size_t n) noexcept {
@@ -358,4 +733,20 @@ private:
     static void Destroy(T* buf) noexcept {
         buf->~T();
     }
-};
\ No newline at end of file
+};
+
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+// Переносит вектор, построенный во время компиляции, в std::array со статическим
+// временем жизни: память, выделенную при константном вычислении, нельзя сохранить
+// в программе. builder - лямбда без захвата, возвращающая Vector. Пример:
+//     constexpr auto TABLE = MaterializeVector([] { return MakeTable(); });
+template <typename Builder>
+consteval auto MaterializeVector(Builder builder) {
+    using Value = std::remove_reference_t<decltype(builder()[0])>;
+    constexpr size_t size = Builder{}().Size();
+    std::array<Value, size> result{};
+    const auto v = builder();
+    std::copy(v.begin(), v.end(), result.begin());
+    return result;
+}
+#endif
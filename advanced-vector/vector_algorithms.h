@@ -0,0 +1,382 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ADVANCED_VECTOR_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+/*
+ * Поиск и свёртки над непрерывным буфером арифметических векторов.
+ * Для int32_t и float на x86 при запуске проверяется поддержка AVX2,
+ * и при её наличии используются векторные ядра; в остальных случаях
+ * работают скалярные циклы, которые компилятор может векторизовать сам.
+ */
+
+// Тип результата Sum и Dot: целые суммируются в 64 бита, чтобы избежать переполнения
+template <typename T>
+using SumType = std::conditional_t<std::is_integral_v<T>,
+                                   std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>, T>;
+
+namespace vector_simd {
+
+/**
+ * Скалярные ядра
+ */
+
+template <typename T>
+const T* Find(const T* data, size_t n, T value) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == value) {
+            return data + i;
+        }
+    }
+    return data + n;
+}
+
+template <typename T>
+size_t Count(const T* data, size_t n, T value) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+template <typename T>
+std::pair<T, T> MinMax(const T* data, size_t n) noexcept {
+    assert(n > 0);
+    T min = data[0];
+    T max = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        min = data[i] < min ? data[i] : min;
+        max = max < data[i] ? data[i] : max;
+    }
+    return {min, max};
+}
+
+// Четыре независимых аккумулятора разрывают цепочку зависимостей сложений
+template <typename T>
+SumType<T> Sum(const T* data, size_t n) noexcept {
+    SumType<T> acc[4] = {};
+    // Граница хвоста известна до циклов: иначе GCC на -O3 предупреждает о
+    // переполнении счётчика в хвосте после векторизации основного цикла
+    const size_t blocked = n - n % 4;
+    for (size_t i = 0; i < blocked; i += 4) {
+        acc[0] += data[i];
+        acc[1] += data[i + 1];
+        acc[2] += data[i + 2];
+        acc[3] += data[i + 3];
+    }
+    for (size_t i = blocked; i < n; ++i) {
+        acc[0] += data[i];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template <typename T>
+SumType<T> Dot(const T* a, const T* b, size_t n) noexcept {
+    SumType<T> acc[4] = {};
+    const size_t blocked = n - n % 4;
+    for (size_t i = 0; i < blocked; i += 4) {
+        acc[0] += static_cast<SumType<T>>(a[i]) * b[i];
+        acc[1] += static_cast<SumType<T>>(a[i + 1]) * b[i + 1];
+        acc[2] += static_cast<SumType<T>>(a[i + 2]) * b[i + 2];
+        acc[3] += static_cast<SumType<T>>(a[i + 3]) * b[i + 3];
+    }
+    for (size_t i = blocked; i < n; ++i) {
+        acc[0] += static_cast<SumType<T>>(a[i]) * b[i];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+#ifdef ADVANCED_VECTOR_X86_DISPATCH
+
+/**
+ * Ядра AVX2. Компилируются с атрибутом target, поэтому не требуют
+ * флагов -mavx2 и вызываются только после проверки HasAvx2()
+ */
+
+inline bool HasAvx2() noexcept {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#define ADVANCED_VECTOR_AVX2 __attribute__((target("avx2")))
+
+ADVANCED_VECTOR_AVX2 inline const int32_t* FindAvx2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if (mask != 0) {
+            return data + i + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return Find(data + i, n - i, value);
+}
+
+ADVANCED_VECTOR_AVX2 inline const float* FindAvx2(const float* data, size_t n, float value) noexcept {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return data + i + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return Find(data + i, n - i, value);
+}
+
+// Счётчики в 32-битных дорожках сбрасываются в size_t раньше, чем могут переполниться
+ADVANCED_VECTOR_AVX2 inline size_t HorizontalCount(__m256i counters) noexcept {
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), counters);
+    size_t count = 0;
+    for (int32_t lane : lanes) {
+        count += static_cast<uint32_t>(-lane);
+    }
+    return count;
+}
+
+constexpr size_t COUNT_FLUSH_BLOCKS = size_t{1} << 30;
+
+ADVANCED_VECTOR_AVX2 inline size_t CountAvx2(const int32_t* data, size_t n, int32_t value) noexcept {
+    const __m256i needle = _mm256_set1_epi32(value);
+    __m256i counters = _mm256_setzero_si256();
+    size_t count = 0;
+    size_t blocks = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        // Совпавшие дорожки равны -1, поэтому сложение уменьшает счётчики
+        counters = _mm256_add_epi32(counters, _mm256_cmpeq_epi32(block, needle));
+        if (++blocks == COUNT_FLUSH_BLOCKS) {
+            count += HorizontalCount(counters);
+            counters = _mm256_setzero_si256();
+            blocks = 0;
+        }
+    }
+    return count + HorizontalCount(counters) + Count(data + i, n - i, value);
+}
+
+ADVANCED_VECTOR_AVX2 inline size_t CountAvx2(const float* data, size_t n, float value) noexcept {
+    const __m256 needle = _mm256_set1_ps(value);
+    __m256i counters = _mm256_setzero_si256();
+    size_t count = 0;
+    size_t blocks = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 equal = _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ);
+        counters = _mm256_add_epi32(counters, _mm256_castps_si256(equal));
+        if (++blocks == COUNT_FLUSH_BLOCKS) {
+            count += HorizontalCount(counters);
+            counters = _mm256_setzero_si256();
+            blocks = 0;
+        }
+    }
+    return count + HorizontalCount(counters) + Count(data + i, n - i, value);
+}
+
+ADVANCED_VECTOR_AVX2 inline std::pair<int32_t, int32_t> MinMaxAvx2(const int32_t* data, size_t n) noexcept {
+    if (n < 8) {
+        return MinMax(data, n);
+    }
+    __m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i max = min;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        min = _mm256_min_epi32(min, block);
+        max = _mm256_max_epi32(max, block);
+    }
+    alignas(32) int32_t min_lanes[8];
+    alignas(32) int32_t max_lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min_lanes), min);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(max_lanes), max);
+    std::pair<int32_t, int32_t> result = MinMax(min_lanes, 8);
+    result.second = MinMax(max_lanes, 8).second;
+    if (i < n) {
+        const auto tail = MinMax(data + i, n - i);
+        result.first = std::min(result.first, tail.first);
+        result.second = std::max(result.second, tail.second);
+    }
+    return result;
+}
+
+ADVANCED_VECTOR_AVX2 inline std::pair<float, float> MinMaxAvx2(const float* data, size_t n) noexcept {
+    if (n < 8) {
+        return MinMax(data, n);
+    }
+    __m256 min = _mm256_loadu_ps(data);
+    __m256 max = min;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 block = _mm256_loadu_ps(data + i);
+        min = _mm256_min_ps(min, block);
+        max = _mm256_max_ps(max, block);
+    }
+    alignas(32) float min_lanes[8];
+    alignas(32) float max_lanes[8];
+    _mm256_store_ps(min_lanes, min);
+    _mm256_store_ps(max_lanes, max);
+    std::pair<float, float> result = MinMax(min_lanes, 8);
+    result.second = MinMax(max_lanes, 8).second;
+    if (i < n) {
+        const auto tail = MinMax(data + i, n - i);
+        result.first = std::min(result.first, tail.first);
+        result.second = std::max(result.second, tail.second);
+    }
+    return result;
+}
+
+ADVANCED_VECTOR_AVX2 inline int64_t SumAvx2(const int32_t* data, size_t n) noexcept {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(low));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(high));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + Sum(data + i, n - i);
+}
+
+ADVANCED_VECTOR_AVX2 inline float SumAvx2(const float* data, size_t n) noexcept {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(data + i));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(data + i + 8));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+    return Sum(lanes, 8) + Sum(data + i, n - i);
+}
+
+ADVANCED_VECTOR_AVX2 inline int64_t DotAvx2(const int32_t* a, const int32_t* b, size_t n) noexcept {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // _mm256_mul_epi32 перемножает чётные дорожки, нечётные сдвигаются на их место
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(va, vb));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + Dot(a + i, b + i, n - i);
+}
+
+ADVANCED_VECTOR_AVX2 inline float DotAvx2(const float* a, const float* b, size_t n) noexcept {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+    return Sum(lanes, 8) + Dot(a + i, b + i, n - i);
+}
+
+#undef ADVANCED_VECTOR_AVX2
+
+/**
+ * Диспетчеризация: перегрузки для int32_t и float выбирают ядро во время выполнения
+ */
+
+inline const int32_t* Find(const int32_t* data, size_t n, int32_t value) noexcept {
+    return HasAvx2() ? FindAvx2(data, n, value) : Find<int32_t>(data, n, value);
+}
+
+inline const float* Find(const float* data, size_t n, float value) noexcept {
+    return HasAvx2() ? FindAvx2(data, n, value) : Find<float>(data, n, value);
+}
+
+inline size_t Count(const int32_t* data, size_t n, int32_t value) noexcept {
+    return HasAvx2() ? CountAvx2(data, n, value) : Count<int32_t>(data, n, value);
+}
+
+inline size_t Count(const float* data, size_t n, float value) noexcept {
+    return HasAvx2() ? CountAvx2(data, n, value) : Count<float>(data, n, value);
+}
+
+inline std::pair<int32_t, int32_t> MinMax(const int32_t* data, size_t n) noexcept {
+    return HasAvx2() ? MinMaxAvx2(data, n) : MinMax<int32_t>(data, n);
+}
+
+inline std::pair<float, float> MinMax(const float* data, size_t n) noexcept {
+    return HasAvx2() ? MinMaxAvx2(data, n) : MinMax<float>(data, n);
+}
+
+inline int64_t Sum(const int32_t* data, size_t n) noexcept {
+    return HasAvx2() ? SumAvx2(data, n) : Sum<int32_t>(data, n);
+}
+
+inline float Sum(const float* data, size_t n) noexcept {
+    return HasAvx2() ? SumAvx2(data, n) : Sum<float>(data, n);
+}
+
+inline int64_t Dot(const int32_t* a, const int32_t* b, size_t n) noexcept {
+    return HasAvx2() ? DotAvx2(a, b, n) : Dot<int32_t>(a, b, n);
+}
+
+inline float Dot(const float* a, const float* b, size_t n) noexcept {
+    return HasAvx2() ? DotAvx2(a, b, n) : Dot<float>(a, b, n);
+}
+
+#endif  // ADVANCED_VECTOR_X86_DISPATCH
+
+}  // namespace vector_simd
+
+/**
+ * Алгоритмы над Vector
+ */
+
+// Указатель на первый элемент, равный value, либо end()
+template <typename T>
+const T* Find(const Vector<T>& v, const T& value) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Find requires an arithmetic element type");
+    return vector_simd::Find(v.begin(), v.Size(), value);
+}
+
+template <typename T>
+size_t Count(const Vector<T>& v, const T& value) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Count requires an arithmetic element type");
+    return vector_simd::Count(v.begin(), v.Size(), value);
+}
+
+// Минимум и максимум непустого вектора. Значения NaN не поддерживаются
+template <typename T>
+std::pair<T, T> MinMax(const Vector<T>& v) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "MinMax requires an arithmetic element type");
+    assert(v.Size() > 0);
+    return vector_simd::MinMax(v.begin(), v.Size());
+}
+
+// Порядок сложения не фиксирован, поэтому для float результат может
+// отличаться от последовательного суммирования в пределах погрешности
+template <typename T>
+SumType<T> Sum(const Vector<T>& v) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Sum requires an arithmetic element type");
+    return vector_simd::Sum(v.begin(), v.Size());
+}
+
+template <typename T>
+SumType<T> Dot(const Vector<T>& a, const Vector<T>& b) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Dot requires an arithmetic element type");
+    assert(a.Size() == b.Size());
+    return vector_simd::Dot(a.begin(), b.begin(), a.Size());
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/*
+ * Двоичное сохранение и загрузка Vector<T> для тривиально копируемых T.
+ * Формат: заголовок VectorFileHeader и следом буфер элементов как есть.
+ * Буфер пишется одним вызовом write и читается одним вызовом read
+ * прямо в память вектора, без поэлементного конструирования.
+ */
+
+struct VectorFileHeader {
+    static constexpr uint32_t MAGIC = 0x43455641;  // "AVEC"
+    static constexpr uint16_t VERSION = 1;
+    // Записывается в родном порядке байт; при чтении на машине с другим порядком не совпадёт
+    static constexpr uint16_t ENDIANNESS = 0x0102;
+
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    uint16_t endianness = ENDIANNESS;
+    uint64_t type_tag = 0;
+    uint64_t element_size = 0;
+    uint64_t count = 0;
+    uint64_t checksum = 0;
+};
+
+// Контрольная сумма буфера. Обрабатывает по 8 байт за шаг, чтобы не стать
+// узким местом при загрузке многогигабайтных векторов
+inline uint64_t VectorChecksum(const void* data, size_t size) noexcept {
+    constexpr uint64_t PRIME = 0x9E3779B97F4A7C15ull;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0xCBF29CE484222325ull ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * PRIME;
+    }
+    return hash ^ (hash >> 32);
+}
+
+// type_tag задаётся вызывающей стороной и позволяет отличить файлы с разными типами
+// одинакового размера
+template <typename T>
+void Save(std::ostream& out, const Vector<T>& v, uint64_t type_tag = 0) {
+    static_assert(std::is_trivially_copyable_v<T>, "Save requires a trivially copyable type");
+    VectorFileHeader header;
+    header.type_tag = type_tag;
+    header.element_size = sizeof(T);
+    header.count = v.Size();
+    header.checksum = VectorChecksum(v.begin(), v.Size() * sizeof(T));
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(v.begin()), static_cast<std::streamsize>(v.Size() * sizeof(T)));
+    if (!out) {
+        throw std::runtime_error("Failed to write vector");
+    }
+}
+
+namespace vector_io_detail {
+
+// Число байт от текущей позиции до конца потока или -1, если поток не позиционируется
+inline std::streamoff RemainingBytes(std::istream& in) {
+    const std::streampos position = in.tellg();
+    if (position == std::streampos(-1)) {
+        in.clear();
+        return -1;
+    }
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.clear();
+    in.seekg(position);
+    if (end == std::streampos(-1) || !in) {
+        in.clear();
+        return -1;
+    }
+    return end - position;
+}
+
+}  // namespace vector_io_detail
+
+template <typename T>
+Vector<T> Load(std::istream& in, uint64_t type_tag = 0) {
+    static_assert(std::is_trivially_copyable_v<T>, "Load requires a trivially copyable type");
+    VectorFileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Failed to read vector header");
+    }
+    if (header.magic != VectorFileHeader::MAGIC || header.version != VectorFileHeader::VERSION) {
+        throw std::runtime_error("Not a vector file");
+    }
+    if (header.endianness != VectorFileHeader::ENDIANNESS) {
+        throw std::runtime_error("Vector file has foreign byte order");
+    }
+    if (header.type_tag != type_tag || header.element_size != sizeof(T)) {
+        throw std::runtime_error("Vector file element type mismatch");
+    }
+    if (header.count > static_cast<uint64_t>(-1) / sizeof(T)) {
+        throw std::runtime_error("Vector file is corrupted");
+    }
+
+    // Размер из заголовка не проверен: прежде чем выделять под него память, убеждаемся,
+    // что в потоке столько данных есть. Непозиционируемый поток читается частями,
+    // и память растёт вместе с реально прочитанными данными
+    Vector<T> result;
+    const std::streamoff remaining = vector_io_detail::RemainingBytes(in);
+    if (remaining >= 0) {
+        if (header.count * sizeof(T) > static_cast<uint64_t>(remaining)) {
+            throw std::runtime_error("Vector file is truncated");
+        }
+        result.Reserve(header.count);
+    }
+    constexpr size_t CHUNK = std::max<size_t>(1, (size_t{1} << 20) / sizeof(T));
+    for (size_t loaded = 0; loaded < header.count;) {
+        const size_t n = std::min<uint64_t>(CHUNK, header.count - loaded);
+        T* data = result.AppendUninitialized(n);
+        if (!in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n * sizeof(T)))) {
+            throw std::runtime_error("Vector file is truncated");
+        }
+        loaded += n;
+    }
+    if (VectorChecksum(result.begin(), header.count * sizeof(T)) != header.checksum) {
+        throw std::runtime_error("Vector file checksum mismatch");
+    }
+    return result;
+}
+
+template <typename T>
+void SaveToFile(const std::string& path, const Vector<T>& v, uint64_t type_tag = 0) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    Save(out, v, type_tag);
+}
+
+template <typename T>
+Vector<T> LoadFromFile(const std::string& path, uint64_t type_tag = 0) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path + " for reading");
+    }
+    return Load<T>(in, type_tag);
+}
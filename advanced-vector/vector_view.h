@@ -0,0 +1,105 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <type_traits>
+
+/*
+ * Невладеющее представление непрерывного массива с интерфейсом чтения Vector.
+ * Позволяет применять одни и те же алгоритмы к Vector и к чужой памяти
+ * (отображённым файлам, сетевым буферам) без копирования.
+ * VectorView<const T> (ConstVectorView<T>) запрещает изменение элементов.
+ */
+template <typename T>
+class VectorView {
+public:
+    using value_type = std::remove_const_t<T>;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * Конструкторы
+     */
+    VectorView() = default;
+
+    VectorView(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+    }
+
+    VectorView(Vector<value_type>& v) noexcept
+        : data_(v.begin())
+        , size_(v.Size()) {
+    }
+
+    template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+    VectorView(const Vector<value_type>& v) noexcept
+        : data_(v.begin())
+        , size_(v.Size()) {
+    }
+
+    // Изменяемое представление неявно приводится к константному
+    template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+    VectorView(VectorView<value_type> other) noexcept
+        : data_(other.begin())
+        , size_(other.Size()) {
+    }
+
+    /**
+     * Итераторы
+     */
+
+    iterator begin() const noexcept {
+        return data_;
+    }
+
+    iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return data_;
+    }
+
+    const_iterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    /**
+     * Операторы
+     */
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    /**
+     * Методы
+     */
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    // Представление count элементов, начиная с offset
+    VectorView SubView(size_t offset, size_t count) const noexcept {
+        assert(offset <= size_ && count <= size_ - offset);
+        return VectorView(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename T>
+using ConstVectorView = VectorView<const T>;